@@ -1,6 +1,7 @@
 #pragma once
 
 #include <new>
+#include <optional>
 #include <atomic>
 #include <chrono>
 #include <thread>
@@ -55,7 +56,11 @@ struct alignas(hardware_destructive_interference_size) fast_queue
 
     write_lock write_acquire(T*& data);
     read_lock read_acquire(T*& data);
+    // Never waits, empty unless the next entry is fully written
+    std::optional<read_lock> try_read_acquire(T*& data);
     bool empty() const;
+    // Only meaningful to a single producer and consumer, write_acquire never waits when this is false
+    bool full() const;
 
 protected:
 
@@ -131,6 +136,24 @@ typename fast_queue<T, Exponent>::read_lock fast_queue<T, Exponent>::read_acquir
     return read_lock(loc, *this);
 }
 
+template<class T, size_t Exponent>
+std::optional<typename fast_queue<T, Exponent>::read_lock> fast_queue<T, Exponent>::try_read_acquire(T*& data)
+{
+    auto loc = m_first.load(std::memory_order_relaxed);
+    auto& entry = m_buffer[index(loc)];
+    const auto rnd = round(loc) << 1;
+    if (rnd + 1 != entry.state.load(std::memory_order_acquire))
+        return std::nullopt;
+
+    // Another consumer may have taken it in the meantime
+    if (!m_first.compare_exchange_strong(loc, loc + 1))
+        return std::nullopt;
+
+    data = &entry.data;
+
+    return std::optional<read_lock>(std::in_place, loc, *this);
+}
+
 template<class T, size_t Exponent>
 inline void fast_queue<T, Exponent>::read_release(size_t cookie)
 {
@@ -145,3 +168,10 @@ inline bool fast_queue<T, Exponent>::empty() const
 {
     return m_first.load(std::memory_order_relaxed) == m_last.load(std::memory_order_relaxed);
 }
+
+template<class T, size_t Exponent>
+inline bool fast_queue<T, Exponent>::full() const
+{
+    // The entry the consumer is reading isn't released yet, it only counts as free once the next one is acquired
+    return m_last.load(std::memory_order_relaxed) - m_first.load(std::memory_order_acquire) >= kSize - 1;
+}
@@ -0,0 +1,211 @@
+#include "JobSystem.h"
+#include "ThreadUtils.h"
+
+#include <algorithm>
+#include <string>
+
+namespace
+{
+// Worker index of the calling thread in the pool it belongs to
+thread_local const Base::JobSystem* t_pPool = nullptr;
+thread_local size_t t_workerIndex = 0;
+} // namespace
+
+namespace Base
+{
+JobSystem::JobSystem(uint32_t aWorkerCount) noexcept
+{
+    if (aWorkerCount == 0)
+        aWorkerCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+    m_workers.reserve(aWorkerCount);
+    for (uint32_t i = 0; i < aWorkerCount; ++i)
+        m_workers.push_back(std::make_unique<Worker>());
+
+    // Only start once every queue exists, workers steal from all of them
+    for (size_t i = 0; i < m_workers.size(); ++i)
+        m_workers[i]->Thread = std::thread(&JobSystem::RunWorker, this, i);
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::scoped_lock _{m_idleLock};
+        m_stop = true;
+    }
+
+    m_idleCondition.notify_all();
+
+    for (auto& pWorker : m_workers)
+    {
+        if (pWorker->Thread.joinable())
+            pWorker->Thread.join();
+    }
+}
+
+JobSystem& JobSystem::Get() noexcept
+{
+    static JobSystem s_instance;
+    return s_instance;
+}
+
+JobSystem::JobHandle JobSystem::Schedule(std::function<void()> aFunction, std::initializer_list<JobHandle> aDependencies) noexcept
+{
+    auto pJob = std::make_shared<Job>();
+    pJob->Function = std::move(aFunction);
+    pJob->PendingCount = 1 + static_cast<uint32_t>(aDependencies.size());
+
+    for (const auto& cpDependency : aDependencies)
+    {
+        bool done = true;
+        if (cpDependency)
+        {
+            std::scoped_lock _{cpDependency->Lock};
+            done = cpDependency->Done;
+            if (!done)
+                cpDependency->Continuations.push_back(pJob);
+        }
+
+        if (done)
+            --pJob->PendingCount;
+    }
+
+    // Drop the scheduling reference, the job is queued now unless a dependency is still running
+    if (--pJob->PendingCount == 0)
+        Enqueue(pJob);
+
+    return pJob;
+}
+
+void JobSystem::Wait(const JobHandle& acJob) noexcept
+{
+    while (!IsDone(acJob))
+    {
+        if (auto pJob = Take())
+            Run(pJob);
+        else
+            std::this_thread::yield();
+    }
+}
+
+bool JobSystem::IsDone(const JobHandle& acJob) noexcept
+{
+    if (!acJob)
+        return true;
+
+    std::scoped_lock _{acJob->Lock};
+    return acJob->Done;
+}
+
+bool JobSystem::IsWorkerThread() noexcept
+{
+    return t_pPool != nullptr;
+}
+
+void JobSystem::Enqueue(JobHandle aJob) noexcept
+{
+    if (m_workers.empty())
+    {
+        Run(aJob);
+        return;
+    }
+
+    // Workers keep what they schedule, everyone else round robins
+    const size_t cIndex = t_pPool == this ? t_workerIndex : m_nextWorker.fetch_add(1, std::memory_order_relaxed) % m_workers.size();
+
+    {
+        // Counted under the queue lock so a thief never takes a job that isn't counted yet
+        auto& worker = *m_workers[cIndex];
+        std::scoped_lock _{worker.Lock};
+        worker.Jobs.push_back(std::move(aJob));
+        m_queuedCount.fetch_add(1, std::memory_order_release);
+    }
+
+    {
+        // Taken so a worker can't miss the count change between its check and its wait
+        std::scoped_lock _{m_idleLock};
+    }
+
+    m_idleCondition.notify_one();
+}
+
+void JobSystem::Run(const JobHandle& acJob) noexcept
+{
+    acJob->Function();
+    acJob->Function = nullptr;
+
+    std::vector<JobHandle> continuations;
+    {
+        std::scoped_lock _{acJob->Lock};
+        acJob->Done = true;
+        std::swap(continuations, acJob->Continuations);
+    }
+
+    for (auto& pContinuation : continuations)
+    {
+        if (--pContinuation->PendingCount == 0)
+            Enqueue(std::move(pContinuation));
+    }
+}
+
+JobSystem::JobHandle JobSystem::Take() noexcept
+{
+    if (m_queuedCount.load(std::memory_order_acquire) == 0)
+        return nullptr;
+
+    const bool cIsWorker = t_pPool == this;
+    const size_t cStart = cIsWorker ? t_workerIndex : 0;
+
+    for (size_t i = 0; i < m_workers.size(); ++i)
+    {
+        const size_t cIndex = (cStart + i) % m_workers.size();
+        auto& worker = *m_workers[cIndex];
+
+        std::scoped_lock _{worker.Lock};
+        if (worker.Jobs.empty())
+            continue;
+
+        // Own jobs newest first, they are likely still in cache, stolen ones oldest first
+        JobHandle pJob;
+        if (cIsWorker && cIndex == t_workerIndex)
+        {
+            pJob = std::move(worker.Jobs.back());
+            worker.Jobs.pop_back();
+        }
+        else
+        {
+            pJob = std::move(worker.Jobs.front());
+            worker.Jobs.pop_front();
+        }
+
+        m_queuedCount.fetch_sub(1, std::memory_order_acq_rel);
+        return pJob;
+    }
+
+    return nullptr;
+}
+
+void JobSystem::RunWorker(size_t aIndex) noexcept
+{
+    t_pPool = this;
+    t_workerIndex = aIndex;
+
+    const std::string cName = "JobWorker" + std::to_string(aIndex);
+    SetCurrentThreadName(cName.c_str());
+
+    while (true)
+    {
+        if (auto pJob = Take())
+        {
+            Run(pJob);
+            continue;
+        }
+
+        std::unique_lock lock{m_idleLock};
+        m_idleCondition.wait(lock, [this]() { return m_stop || m_queuedCount.load(std::memory_order_acquire) > 0; });
+
+        if (m_stop)
+            return;
+    }
+}
+} // namespace Base
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Base
+{
+// Work stealing thread pool.
+// Every worker owns a queue, it runs the jobs it scheduled itself newest first and steals the oldest jobs of the
+// other workers when it runs dry. Jobs scheduled from outside the pool are spread over the workers. A thread that
+// waits on a job runs queued jobs in the meantime, so waiting from a job doesn't dead lock the pool.
+class JobSystem
+{
+  public:
+    struct Job;
+    using JobHandle = std::shared_ptr<Job>;
+
+    // 0 uses one worker per hardware thread, minus the calling thread.
+    explicit JobSystem(uint32_t aWorkerCount = 0) noexcept;
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Shared pool, created on first use.
+    static JobSystem& Get() noexcept;
+
+    // The job runs once every dependency has completed, dependencies form the task graph.
+    JobHandle Schedule(std::function<void()> aFunction, std::initializer_list<JobHandle> aDependencies = {}) noexcept;
+    // Runs queued jobs until the job has completed.
+    void Wait(const JobHandle& acJob) noexcept;
+    [[nodiscard]] static bool IsDone(const JobHandle& acJob) noexcept;
+    // Whether the calling thread is a worker of any pool, code that is only safe on the game thread can check this.
+    [[nodiscard]] static bool IsWorkerThread() noexcept;
+
+    // Calls acFunctor(begin, end) over [0, aCount) in chunks of at most aGrainSize and returns once all of them
+    // completed. The calling thread runs chunks too.
+    template <class T> void ParallelFor(size_t aCount, size_t aGrainSize, const T& acFunctor) noexcept
+    {
+        if (aCount == 0)
+            return;
+
+        aGrainSize = aGrainSize == 0 ? 1 : aGrainSize;
+
+        // Not worth a round trip through the queues
+        if (aCount <= aGrainSize || m_workers.empty())
+        {
+            acFunctor(size_t(0), aCount);
+            return;
+        }
+
+        std::vector<JobHandle> chunks;
+        chunks.reserve((aCount + aGrainSize - 1) / aGrainSize);
+
+        for (size_t begin = aGrainSize; begin < aCount; begin += aGrainSize)
+        {
+            const size_t end = std::min(begin + aGrainSize, aCount);
+            chunks.push_back(Schedule([&acFunctor, begin, end]() { acFunctor(begin, end); }));
+        }
+
+        acFunctor(size_t(0), aGrainSize);
+
+        for (const auto& cChunk : chunks)
+            Wait(cChunk);
+    }
+
+    [[nodiscard]] size_t GetWorkerCount() const noexcept { return m_workers.size(); }
+
+  private:
+    struct Worker
+    {
+        std::mutex Lock;
+        std::deque<JobHandle> Jobs;
+        std::thread Thread;
+    };
+
+    void Enqueue(JobHandle aJob) noexcept;
+    void Run(const JobHandle& acJob) noexcept;
+    // Pops a job of the calling worker, or steals one, returns null when every queue is empty.
+    JobHandle Take() noexcept;
+    void RunWorker(size_t aIndex) noexcept;
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::atomic<size_t> m_nextWorker{0};
+
+    // Idle workers sleep here until jobs are queued
+    std::mutex m_idleLock;
+    std::condition_variable m_idleCondition;
+    std::atomic<size_t> m_queuedCount{0};
+    bool m_stop{false};
+};
+
+struct JobSystem::Job
+{
+    std::function<void()> Function;
+    // Dependencies left, plus one while the job is being scheduled
+    std::atomic<uint32_t> PendingCount{1};
+
+    std::mutex Lock;
+    bool Done{false};
+    std::vector<JobHandle> Continuations;
+};
+} // namespace Base
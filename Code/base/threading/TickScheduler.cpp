@@ -0,0 +1,168 @@
+
+#include "TickScheduler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <timeapi.h>
+#pragma comment(lib, "winmm.lib")
+#endif
+
+namespace
+{
+using namespace std::chrono_literals;
+
+// Past this many samples the estimate is restarted so it follows changes in system load.
+constexpr uint64_t kMaxSleepSamples = 4096;
+#ifndef _WIN32
+// High resolution timers make short sleeps cheap and accurate enough for the last part of the wait.
+constexpr auto kFinalSleep = 50us;
+#endif
+
+Base::TickScheduler::Clock::duration ToDuration(double aSeconds) noexcept
+{
+    return std::chrono::duration_cast<Base::TickScheduler::Clock::duration>(std::chrono::duration<double>(aSeconds));
+}
+
+double ToSeconds(Base::TickScheduler::Clock::duration aDuration) noexcept
+{
+    return std::chrono::duration<double>(aDuration).count();
+}
+} // namespace
+
+namespace Base
+{
+TickScheduler::TickScheduler(uint32_t aTickRate) noexcept
+    : m_nextDeadline(Clock::now())
+{
+#ifdef _WIN32
+    // Without this the scheduler granularity is ~15.6ms and the sleep overshoot would eat most of the tick.
+    timeBeginPeriod(1);
+#endif
+
+    SetTickRate(aTickRate);
+}
+
+TickScheduler::~TickScheduler()
+{
+#ifdef _WIN32
+    timeEndPeriod(1);
+#endif
+}
+
+void TickScheduler::SetTickRate(uint32_t aTickRate) noexcept
+{
+    m_period = std::chrono::duration_cast<Clock::duration>(1s) / std::max(aTickRate, 1u);
+}
+
+void TickScheduler::BeginTick() noexcept
+{
+    const auto cNow = Clock::now();
+    const auto cJitter = std::max(cNow - m_nextDeadline, Clock::duration::zero());
+
+    const double cJitterSeconds = ToSeconds(cJitter);
+    m_jitterSum += cJitterSeconds;
+    m_jitterSquareSum += cJitterSeconds * cJitterSeconds;
+    m_maxJitter = std::max(m_maxJitter, cJitter);
+    ++m_tickCount;
+
+    // If we fell behind by more than a tick, don't try to catch up with a burst of back to back ticks.
+    if (cJitter > m_period)
+    {
+        ++m_overrunCount;
+        m_nextDeadline = cNow;
+    }
+
+    m_tickStart = cNow;
+    m_nextDeadline += m_period;
+}
+
+void TickScheduler::EndTick() noexcept
+{
+    const auto cDuration = Clock::now() - m_tickStart;
+
+    m_durationSum += cDuration;
+    m_maxDuration = std::max(m_maxDuration, cDuration);
+}
+
+TickScheduler::Clock::duration TickScheduler::GetCoarseWaitTime() const noexcept
+{
+    const auto cSpinMargin = ToDuration(m_sleepMean + std::sqrt(m_sleepM2 / m_sleepSamples));
+    const auto cRemaining = m_nextDeadline - Clock::now();
+
+    return std::max(cRemaining - cSpinMargin, Clock::duration::zero());
+}
+
+void TickScheduler::WaitForNextTick() noexcept
+{
+    // One sleep for the bulk of the wait, the margin left covers its usual overshoot
+    const auto cCoarseWait = GetCoarseWaitTime();
+    if (cCoarseWait > Clock::duration::zero())
+    {
+        const auto cStart = Clock::now();
+        std::this_thread::sleep_for(cCoarseWait);
+        UpdateSleepEstimate(Clock::now() - cStart - cCoarseWait);
+    }
+
+    for (auto remaining = m_nextDeadline - Clock::now(); remaining > Clock::duration::zero(); remaining = m_nextDeadline - Clock::now())
+    {
+#ifdef _WIN32
+        // Sleeps can't be shorter than the 1ms timer period, they would overshoot the deadline
+        std::this_thread::yield();
+#else
+        std::this_thread::sleep_for(std::min<Clock::duration>(remaining, kFinalSleep));
+#endif
+    }
+}
+
+TickScheduler::Stats TickScheduler::GetStats() const noexcept
+{
+    Stats stats{};
+    stats.TickCount = m_tickCount;
+    stats.OverrunCount = m_overrunCount;
+    stats.MaxJitter = m_maxJitter;
+    stats.MaxDuration = m_maxDuration;
+
+    if (m_tickCount == 0)
+        return stats;
+
+    const double cMeanJitter = m_jitterSum / m_tickCount;
+    const double cVariance = std::max(m_jitterSquareSum / m_tickCount - cMeanJitter * cMeanJitter, 0.0);
+
+    stats.MeanJitter = ToDuration(cMeanJitter);
+    stats.JitterStdDev = ToDuration(std::sqrt(cVariance));
+    stats.MeanDuration = m_durationSum / m_tickCount;
+
+    return stats;
+}
+
+void TickScheduler::ResetStats() noexcept
+{
+    m_tickCount = 0;
+    m_overrunCount = 0;
+    m_jitterSum = 0.0;
+    m_jitterSquareSum = 0.0;
+    m_maxJitter = Clock::duration::zero();
+    m_durationSum = Clock::duration::zero();
+    m_maxDuration = Clock::duration::zero();
+}
+
+void TickScheduler::UpdateSleepEstimate(Clock::duration aObserved) noexcept
+{
+    if (m_sleepSamples >= kMaxSleepSamples)
+    {
+        m_sleepM2 = 0.0;
+        m_sleepSamples = 1;
+    }
+
+    const double cObserved = ToSeconds(aObserved);
+    const double cDelta = cObserved - m_sleepMean;
+
+    ++m_sleepSamples;
+    m_sleepMean += cDelta / m_sleepSamples;
+    m_sleepM2 += cDelta * (cObserved - m_sleepMean);
+}
+} // namespace Base
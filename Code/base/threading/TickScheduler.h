@@ -0,0 +1,66 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace Base
+{
+// Paces a fixed rate loop without spinning on a core between ticks.
+// Waiting is a single OS sleep that stops short of the deadline by the measured sleep overshoot, the margin left is
+// waited in short sleeps (yields on Windows, where sleeps can't go below the 1ms timer period).
+class TickScheduler
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Stats
+    {
+        uint64_t TickCount{};
+        uint64_t OverrunCount{};
+        // Lateness of the tick start relative to its deadline.
+        Clock::duration MeanJitter{};
+        Clock::duration MaxJitter{};
+        Clock::duration JitterStdDev{};
+        // Time spent inside the tick itself.
+        Clock::duration MeanDuration{};
+        Clock::duration MaxDuration{};
+    };
+
+    explicit TickScheduler(uint32_t aTickRate) noexcept;
+    ~TickScheduler();
+
+    void SetTickRate(uint32_t aTickRate) noexcept;
+
+    // Marks the start and end of the work done in a tick, the next deadline is advanced by one period.
+    void BeginTick() noexcept;
+    void EndTick() noexcept;
+
+    // Time left before the next deadline, minus the margin WaitForNextTick keeps for the sleep overshoot.
+    // Callers with their own blocking wait (e.g. an event loop) can block for this long without missing the deadline.
+    [[nodiscard]] Clock::duration GetCoarseWaitTime() const noexcept;
+    void WaitForNextTick() noexcept;
+
+    [[nodiscard]] Stats GetStats() const noexcept;
+    void ResetStats() noexcept;
+
+  private:
+    void UpdateSleepEstimate(Clock::duration aObserved) noexcept;
+
+    Clock::duration m_period;
+    Clock::time_point m_nextDeadline;
+    Clock::time_point m_tickStart;
+
+    // Running estimate of how much longer than requested a sleep takes (Welford mean/variance, in seconds).
+    double m_sleepMean{0.001};
+    double m_sleepM2{0.0};
+    uint64_t m_sleepSamples{1};
+
+    uint64_t m_tickCount{};
+    uint64_t m_overrunCount{};
+    double m_jitterSum{};
+    double m_jitterSquareSum{};
+    Clock::duration m_maxJitter{};
+    Clock::duration m_durationSum{};
+    Clock::duration m_maxDuration{};
+};
+} // namespace Base
@@ -265,7 +265,7 @@ void CharacterService::OnConnected(const ConnectedEvent& acConnectedEvent) const
     }
 }
 
-void CharacterService::OnDisconnected(const DisconnectedEvent& acDisconnectedEvent) const noexcept
+void CharacterService::OnDisconnected(const DisconnectedEvent& acDisconnectedEvent) noexcept
 {
     auto remoteView = m_world.view<FormIdComponent, RemoteComponent>();
     for (auto entity : remoteView)
@@ -283,6 +283,8 @@ void CharacterService::OnDisconnected(const DisconnectedEvent& acDisconnectedEve
     }
 
     m_world.clear<WaitingForAssignmentComponent, LocalComponent, RemoteComponent>();
+
+    m_movementBaselines.clear();
 }
 
 void CharacterService::OnAssignCharacter(const AssignCharacterResponse& acMessage) noexcept
@@ -558,12 +560,22 @@ void CharacterService::OnRemoteSpawnDataReceived(const NotifySpawnData& acMessag
     spdlog::info("Applied remote spawn data, actor form id: {:X}", pActor->formID);
 }
 
-void CharacterService::OnReferencesMoveRequest(const ServerReferencesMoveRequest& acMessage) const noexcept
+void CharacterService::OnReferencesMoveRequest(const ServerReferencesMoveRequest& acMessage) noexcept
 {
     auto view = m_world.view<RemoteComponent, InterpolationComponent, RemoteAnimationComponent>();
 
     for (const auto& [serverId, update] : acMessage.Updates)
     {
+        // The baseline has to follow the server even if we don't have the entity
+        if (update.IsDelta && m_movementBaselines.find(serverId) == std::end(m_movementBaselines))
+        {
+            spdlog::warn("Received a movement delta without baseline for server id {:X}", serverId);
+            continue;
+        }
+
+        auto& movement = m_movementBaselines[serverId];
+        update.ApplyTo(movement);
+
         auto itor = std::find_if(std::begin(view), std::end(view), [serverId = serverId, view](entt::entity entity)
         {
             return view.get<RemoteComponent>(entity).Id == serverId;
@@ -574,7 +586,6 @@ void CharacterService::OnReferencesMoveRequest(const ServerReferencesMoveRequest
 
         auto& interpolationComponent = view.get<InterpolationComponent>(*itor);
         auto& animationComponent = view.get<RemoteAnimationComponent>(*itor);
-        const auto& movement = update.UpdatedMovement;
 
         InterpolationComponent::TimePoint point;
         point.Tick = acMessage.Tick;
@@ -664,8 +675,10 @@ void CharacterService::OnOwnershipTransfer(const NotifyOwnershipTransfer& acMess
     m_transport.Send(request);
 }
 
-void CharacterService::OnRemoveCharacter(const NotifyRemoveCharacter& acMessage) const noexcept
+void CharacterService::OnRemoveCharacter(const NotifyRemoveCharacter& acMessage) noexcept
 {
+    m_movementBaselines.erase(acMessage.ServerId);
+
     auto view = m_world.view<RemoteComponent>();
 
     const auto itor = std::find_if(std::begin(view), std::end(view), [id = acMessage.ServerId, view](entt::entity entity) {
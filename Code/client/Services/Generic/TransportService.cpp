@@ -17,6 +17,7 @@
 
 #include <Messages/AuthenticationRequest.h>
 #include <Messages/ServerMessageFactory.h>
+#include <MessageBundle.h>
 #include <Messages/NotifySettingsChange.h>
 #include <Packet.hpp>
 
@@ -91,6 +92,16 @@ bool TransportService::Send(const ClientMessage& acMessage) const noexcept
 
 void TransportService::OnConsume(const void* apData, uint32_t aSize)
 {
+    // The server packs the messages of a tick together, each one is handled like a packet of its own
+    if (MessageBundle::IsBundle(apData, aSize))
+    {
+        const auto cHandler = [this](const uint8_t* apMessage, size_t aMessageSize) { OnConsume(apMessage, static_cast<uint32_t>(aMessageSize)); };
+        if (!MessageBundle::ForEach(apData, aSize, cHandler))
+            spdlog::error("Couldn't parse message bundle from server");
+
+        return;
+    }
+
     ServerMessageFactory factory;
     TiltedPhoques::ViewBuffer buf((uint8_t*)apData, aSize);
     Buffer::Reader reader(&buf);
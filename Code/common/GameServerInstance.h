@@ -12,6 +12,9 @@ class IGameServerInstance
     virtual bool IsListening() = 0;
     virtual bool IsRunning() = 0;
 
+    // rate at which the runner should call Update()
+    virtual uint32_t GetTickRate() = 0;
+
     // update the server logic
     virtual void Update() = 0;
 };
@@ -1,8 +1,12 @@
 
 
 #include "ESLoader.h"
+#include "RecordCache.h"
+#include <algorithm>
+#include <atomic>
 #include <filesystem>
 #include <fstream>
+#include <thread>
 
 #include <Records/CLMT.h>
 #include <Records/NPC.h>
@@ -27,8 +31,13 @@ String ReadWString(Buffer::Reader& aReader) noexcept
 }
 
 ESLoader::ESLoader()
+    : ESLoader(fs::current_path() / "Data") //< Keep upper case to match Skyrim's file system
 {
-    m_directory = fs::current_path() / "Data"; //< Keep upper case to match Skyrim's file system
+}
+
+ESLoader::ESLoader(const fs::path& acDirectory)
+{
+    m_directory = acDirectory;
 }
 
 UniquePtr<RecordCollection> ESLoader::BuildRecordCollection() noexcept
@@ -44,14 +53,8 @@ UniquePtr<RecordCollection> ESLoader::BuildRecordCollection() noexcept
         return nullptr;
     }
 
-    return MakeUnique<RecordCollection>();
-
-    /*
-    auto recordCollection = LoadFiles();
-    recordCollection->BuildReferences();
-
-    return std::move(recordCollection);
-    */
+    // Only indexes the plugins, records are parsed when first requested
+    return LoadFiles();
 }
 
 bool ESLoader::LoadLoadOrder()
@@ -109,44 +112,95 @@ bool ESLoader::LoadLoadOrder()
 
 UniquePtr<RecordCollection> ESLoader::LoadFiles()
 {
-    auto recordCollection = MakeUnique<RecordCollection>();
+    Map<String, fs::path> dataFiles;
+    for (const auto& entry : fs::directory_iterator(m_directory))
+        dataFiles[entry.path().filename().string().c_str()] = entry.path();
 
-    for (PluginData& plugin : m_loadOrder)
+    Vector<UniquePtr<TESFile>> pluginFiles(m_loadOrder.size());
+    Vector<fs::path> pluginPaths(m_loadOrder.size());
+    Vector<RecordCache::PluginStamp> stamps(m_loadOrder.size());
+    Vector<std::pair<uintmax_t, size_t>> schedule;
+
+    for (size_t i = 0; i < m_loadOrder.size(); ++i)
     {
-        fs::path pluginPath = GetPath(plugin.m_filename);
-        if (pluginPath.empty())
+        const PluginData& plugin = m_loadOrder[i];
+
+        const auto path = dataFiles.find(plugin.m_filename);
+        if (path == std::end(dataFiles))
         {
             spdlog::warn("Path to plugin file not found: {}", plugin.m_filename);
+            stamps[i] = RecordCache::MakeStamp(plugin.m_filename, {});
             continue;
         }
 
-        TESFile pluginFile(m_masterFiles);
-        if (plugin.IsLite())
-            pluginFile.Setup(plugin.m_liteId);
-        else
-            pluginFile.Setup(plugin.m_standardId);
+        pluginPaths[i] = path->second;
+        stamps[i] = RecordCache::MakeStamp(plugin.m_filename, path->second);
+    }
 
-        bool loadResult = pluginFile.LoadFile(pluginPath);
+    if (auto pCachedCollection = m_cachePath.empty() ? nullptr : RecordCache::Load(m_cachePath, stamps, pluginPaths))
+    {
+        spdlog::info("Loaded record index from cache");
+        return pCachedCollection;
+    }
 
-        if (!loadResult)
+    for (size_t i = 0; i < m_loadOrder.size(); ++i)
+    {
+        const PluginData& plugin = m_loadOrder[i];
+        if (pluginPaths[i].empty())
             continue;
 
-        pluginFile.IndexRecords(*recordCollection);
+        auto pPluginFile = MakeUnique<TESFile>(m_masterFiles);
+        if (plugin.IsLite())
+            pPluginFile->Setup(plugin.m_liteId);
+        else
+            pPluginFile->Setup(plugin.m_standardId);
+
+        schedule.emplace_back(stamps[i].m_size, i);
+        pluginFiles[i] = std::move(pPluginFile);
     }
 
-    return recordCollection;
-}
+    // Biggest plugins first so a large master doesn't end up alone on the last thread
+    std::sort(schedule.begin(), schedule.end(), std::greater<>());
 
-fs::path ESLoader::GetPath(String& aFilename)
-{
-    for (const auto& entry : fs::directory_iterator(m_directory))
+    std::atomic<size_t> next = 0;
+    auto indexPlugins = [&]() {
+        for (size_t task = next++; task < schedule.size(); task = next++)
+        {
+            const size_t i = schedule[task].second;
+            if (!pluginFiles[i]->LoadFile(pluginPaths[i]) || !pluginFiles[i]->IndexRecords())
+                pluginFiles[i].reset();
+        }
+    };
+
+    const size_t threadCount = std::clamp<size_t>(std::thread::hardware_concurrency(), 1, std::max<size_t>(schedule.size(), 1));
+
+    Vector<std::thread> workers;
+    for (size_t i = 1; i < threadCount; ++i)
+        workers.emplace_back(indexPlugins);
+
+    indexPlugins();
+
+    for (auto& worker : workers)
+        worker.join();
+
+    // Shards are merged in load order so overrides resolve the same way no matter which thread finished first
+    auto recordCollection = MakeUnique<RecordCollection>();
+    Vector<uint32_t> pluginSlots;
+    for (size_t i = 0; i < pluginFiles.size(); ++i)
     {
-        String filename = entry.path().filename().string().c_str();
-        if (filename == aFilename)
-            return entry.path();
+        if (!pluginFiles[i])
+            continue;
+
+        pluginFiles[i]->MergeInto(*recordCollection);
+        pluginSlots.push_back(static_cast<uint32_t>(i));
     }
 
-    return fs::path();
+    recordCollection->BuildIndex();
+
+    if (!m_cachePath.empty())
+        RecordCache::Save(m_cachePath, stamps, pluginSlots, *recordCollection);
+
+    return recordCollection;
 }
 
 } // namespace ESLoader
@@ -31,6 +31,7 @@ class ESLoader
 {
   public:
     ESLoader();
+    explicit ESLoader(const fs::path& acDirectory);
 
     UniquePtr<RecordCollection> BuildRecordCollection() noexcept;
 
@@ -39,13 +40,23 @@ class ESLoader
         return m_loadOrder;
     }
 
+    const fs::path& GetDirectory() const noexcept
+    {
+        return m_directory;
+    }
+
+    // The record cache is off until a path is set, an empty path disables it again
+    void SetCachePath(const fs::path& acCachePath) noexcept
+    {
+        m_cachePath = acCachePath;
+    }
+
   private:
     bool LoadLoadOrder();
     UniquePtr<RecordCollection> LoadFiles();
 
-    fs::path GetPath(String& aFilename);
-
     fs::path m_directory = "";
+    fs::path m_cachePath = "";
     Vector<PluginData> m_loadOrder{};
     TiltedPhoques::Map<String, uint8_t> m_masterFiles{};
 };
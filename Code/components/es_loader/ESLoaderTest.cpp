@@ -1,8 +1,11 @@
 #include <gtest/gtest.h>
 #include <ESLoader.h>
+#include <SyntheticPlugin.h>
 
 #include <Records/NPC.h>
 
+#include <fstream>
+
 // To properly run these tests, move your Skyrim Data\ dir to the binary's dir,
 // along with a loadorder.txt in the Data\ dir
 namespace
@@ -121,4 +124,232 @@ TEST_F(ESLoaderTest, GetWorldTamriel)
     EXPECT_EQ(tamrielWorld.m_navMeshRefs.size(), 0x3315);
 }
 
+TEST_F(ESLoaderTest, NavMeshLocationMatchesParsedRecord)
+{
+    const auto& pCollection = GetCollection();
+
+    const auto navMeshIds = pCollection->GetFormIdsOfType(FormEnum::NAVM);
+    ASSERT_FALSE(navMeshIds.empty());
+
+    for (size_t i = 0; i < std::min<size_t>(navMeshIds.size(), 256); ++i)
+    {
+        NAVM::Location location{};
+        ASSERT_TRUE(pCollection->GetNavMeshLocation(navMeshIds[i], location));
+
+        NAVM navMesh;
+        ASSERT_TRUE(pCollection->ParseNavMeshById(navMeshIds[i], navMesh));
+
+        EXPECT_EQ(location.m_worldSpaceId, navMesh.m_navMesh.m_worldSpaceId);
+        EXPECT_EQ(location.m_cellId, navMesh.m_navMesh.m_cellId.value_or(0));
+        EXPECT_EQ(location.m_gridX, navMesh.m_navMesh.m_gridX.value_or(0));
+        EXPECT_EQ(location.m_gridY, navMesh.m_navMesh.m_gridY.value_or(0));
+    }
+}
+
+// Runs on plugins written by the benchmark's generator in a temporary directory, no game data needed
+class SyntheticESLoaderTest : public ::testing::Test
+{
+public:
+    static constexpr char kMasterName[] = "SyntheticMaster.esm";
+    static constexpr const char* kPluginNames[] = {"SyntheticPluginA.esp", "SyntheticPluginB.esp"};
+    static constexpr uint32_t kReferences = 512;
+    // Each plugin overrides this many of the master's first references
+    static constexpr uint32_t kOverrides = 32;
+
+    void SetUp() override
+    {
+        const auto* pTest = ::testing::UnitTest::GetInstance()->current_test_info();
+        m_directory = fs::temp_directory_path() / "ESLoaderTest" / pTest->name();
+
+        std::error_code error;
+        fs::remove_all(m_directory, error);
+        fs::create_directories(m_directory / "Plain");
+        fs::create_directories(m_directory / "Compressed");
+    }
+
+    void TearDown() override
+    {
+        std::error_code error;
+        fs::remove_all(m_directory, error);
+    }
+
+    // Writes the master and the plugins in aDirectory, aCompressEvery is passed to every plugin
+    static void WriteDataSet(const fs::path& acDirectory, uint32_t aCompressEvery, uint32_t aPluginReferences = 64)
+    {
+        std::ofstream loadOrder(acDirectory / "loadorder.txt", std::ios::trunc);
+        ASSERT_TRUE(loadOrder);
+
+        SyntheticPluginSettings master{};
+        master.References = kReferences;
+        master.Npcs = 32;
+        master.Containers = 16;
+        master.Worlds = 2;
+        master.NavMeshes = 16;
+        master.NavMeshVertices = 16;
+        master.CompressEvery = aCompressEvery;
+        master.Master = true;
+        master.Seed = 1;
+        WritePlugin(acDirectory, kMasterName, master, loadOrder);
+
+        for (uint32_t i = 0; i < std::size(kPluginNames); ++i)
+        {
+            SyntheticPluginSettings plugin{};
+            plugin.References = aPluginReferences;
+            plugin.Npcs = 4;
+            plugin.CompressEvery = aCompressEvery;
+            plugin.OverridePercent = kOverrides * 100 / aPluginReferences;
+            plugin.Masters.push_back(kMasterName);
+            plugin.Seed = 2 + i;
+            WritePlugin(acDirectory, kPluginNames[i], plugin, loadOrder);
+        }
+    }
+
+    static void WritePlugin(const fs::path& acDirectory, const char* acpFilename, const SyntheticPluginSettings& acSettings, std::ofstream& aLoadOrder)
+    {
+        SyntheticPluginStatistics statistics{};
+        ASSERT_TRUE(WriteSyntheticPlugin(acDirectory / acpFilename, acSettings, statistics));
+        aLoadOrder << acpFilename << '\n';
+    }
+
+    static UniquePtr<ESLoader::RecordCollection> Load(const fs::path& acDirectory, const fs::path& acCachePath = {})
+    {
+        ESLoader::ESLoader loader(acDirectory);
+        loader.SetCachePath(acCachePath);
+        return loader.BuildRecordCollection();
+    }
+
+    // Parses every record of the types the loader knows in both collections and compares them
+    static void ExpectSameRecords(ESLoader::RecordCollection& aExpected, ESLoader::RecordCollection& aActual)
+    {
+        ASSERT_EQ(aExpected.GetRecordCount(), aActual.GetRecordCount());
+
+        for (FormEnum type : {FormEnum::REFR, FormEnum::NPC_, FormEnum::CONT, FormEnum::WRLD, FormEnum::NAVM})
+            ASSERT_EQ(aExpected.GetFormIdsOfType(type), aActual.GetFormIdsOfType(type));
+
+        for (uint32_t formId : aExpected.GetFormIdsOfType(FormEnum::REFR))
+        {
+            const REFR& expected = aExpected.GetObjectRefById(formId);
+            const REFR& actual = aActual.GetObjectRefById(formId);
+
+            EXPECT_EQ(expected.GetFormId(), actual.GetFormId());
+            EXPECT_EQ(expected.m_basicObject.m_baseId, actual.m_basicObject.m_baseId);
+            EXPECT_EQ(expected.m_markerData.m_isMarker, actual.m_markerData.m_isMarker);
+        }
+
+        for (uint32_t formId : aExpected.GetFormIdsOfType(FormEnum::NPC_))
+        {
+            const NPC& expected = aExpected.GetNpcById(formId);
+            const NPC& actual = aActual.GetNpcById(formId);
+
+            EXPECT_EQ(expected.m_editorId, actual.m_editorId);
+            EXPECT_EQ(expected.m_baseStats.IsUnique(), actual.m_baseStats.IsUnique());
+            EXPECT_EQ(expected.m_defaultOutfit.m_formId, actual.m_defaultOutfit.m_formId);
+            EXPECT_EQ(expected.m_scriptData.m_scriptCount, actual.m_scriptData.m_scriptCount);
+        }
+
+        for (uint32_t formId : aExpected.GetFormIdsOfType(FormEnum::CONT))
+        {
+            const CONT& expected = aExpected.GetContainerById(formId);
+            const CONT& actual = aActual.GetContainerById(formId);
+
+            EXPECT_EQ(expected.m_editorId, actual.m_editorId);
+            ASSERT_EQ(expected.m_objects.size(), actual.m_objects.size());
+            for (size_t i = 0; i < expected.m_objects.size(); ++i)
+            {
+                EXPECT_EQ(expected.m_objects[i].m_formId, actual.m_objects[i].m_formId);
+                EXPECT_EQ(expected.m_objects[i].m_count, actual.m_objects[i].m_count);
+            }
+        }
+
+        for (uint32_t formId : aExpected.GetFormIdsOfType(FormEnum::WRLD))
+            EXPECT_EQ(aExpected.GetWorldById(formId).m_editorId, aActual.GetWorldById(formId).m_editorId);
+
+        for (uint32_t formId : aExpected.GetFormIdsOfType(FormEnum::NAVM))
+        {
+            const auto& expected = aExpected.GetNavMeshById(formId).m_navMesh;
+            const auto& actual = aActual.GetNavMeshById(formId).m_navMesh;
+
+            EXPECT_EQ(expected.m_worldSpaceId, actual.m_worldSpaceId);
+            EXPECT_EQ(expected.m_cellId, actual.m_cellId);
+            EXPECT_EQ(expected.m_gridX, actual.m_gridX);
+            EXPECT_EQ(expected.m_gridY, actual.m_gridY);
+            EXPECT_EQ(expected.m_vertices, actual.m_vertices);
+            EXPECT_EQ(expected.m_triangles.size(), actual.m_triangles.size());
+        }
+    }
+
+    fs::path m_directory;
+};
+
+TEST_F(SyntheticESLoaderTest, OverridesResolveToLastPlugin)
+{
+    ASSERT_NO_FATAL_FAILURE(WriteDataSet(m_directory / "Plain", 0));
+
+    auto pCollection = Load(m_directory / "Plain");
+    ASSERT_TRUE(pCollection);
+
+    // Without containers the plugins point their references at themselves, the base id tells who wrote them
+    for (uint32_t i = 0; i < kReferences; ++i)
+    {
+        const REFR& reference = pCollection->GetObjectRefById(0x800 + i);
+        const uint32_t expectedPlugin = i < kOverrides ? static_cast<uint32_t>(std::size(kPluginNames)) : 0;
+
+        EXPECT_EQ(reference.m_basicObject.m_baseId >> 24, expectedPlugin) << "reference " << i;
+    }
+}
+
+TEST_F(SyntheticESLoaderTest, CachedLoadMatchesColdLoad)
+{
+    const fs::path directory = m_directory / "Plain";
+    const fs::path cachePath = directory / "RecordCache.bin";
+    ASSERT_NO_FATAL_FAILURE(WriteDataSet(directory, 0));
+
+    auto pCold = Load(directory);
+    ASSERT_TRUE(pCold);
+
+    // The first load builds the cache, the second one reads it
+    ASSERT_TRUE(Load(directory, cachePath));
+    ASSERT_TRUE(fs::exists(cachePath));
+
+    auto pCached = Load(directory, cachePath);
+    ASSERT_TRUE(pCached);
+
+    ExpectSameRecords(*pCold, *pCached);
+}
+
+TEST_F(SyntheticESLoaderTest, TouchedPluginInvalidatesCache)
+{
+    const fs::path directory = m_directory / "Plain";
+    const fs::path cachePath = directory / "RecordCache.bin";
+    ASSERT_NO_FATAL_FAILURE(WriteDataSet(directory, 0));
+
+    ASSERT_TRUE(Load(directory, cachePath));
+    ASSERT_TRUE(fs::exists(cachePath));
+
+    // Same plugins with more references, bumped well past the cached time in case the clock is coarse
+    ASSERT_NO_FATAL_FAILURE(WriteDataSet(directory, 0, 128));
+    const fs::path plugin = directory / kPluginNames[0];
+    fs::last_write_time(plugin, fs::last_write_time(plugin) + std::chrono::hours(1));
+
+    auto pCold = Load(directory);
+    auto pCached = Load(directory, cachePath);
+    ASSERT_TRUE(pCold);
+    ASSERT_TRUE(pCached);
+
+    ExpectSameRecords(*pCold, *pCached);
+}
+
+TEST_F(SyntheticESLoaderTest, CompressedRecordsMatchPlainRecords)
+{
+    ASSERT_NO_FATAL_FAILURE(WriteDataSet(m_directory / "Plain", 0));
+    ASSERT_NO_FATAL_FAILURE(WriteDataSet(m_directory / "Compressed", 2));
+
+    auto pPlain = Load(m_directory / "Plain");
+    auto pCompressed = Load(m_directory / "Compressed");
+    ASSERT_TRUE(pPlain);
+    ASSERT_TRUE(pCompressed);
+
+    ExpectSameRecords(*pPlain, *pCompressed);
+}
+
 } // namespace
@@ -0,0 +1,110 @@
+#include "MappedFile.h"
+
+#include <utility>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ESLoader
+{
+MappedFile::~MappedFile() noexcept
+{
+    Close();
+}
+
+MappedFile::MappedFile(MappedFile&& aRhs) noexcept
+    : m_pData(std::exchange(aRhs.m_pData, nullptr))
+    , m_size(std::exchange(aRhs.m_size, 0))
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& aRhs) noexcept
+{
+    if (this != &aRhs)
+    {
+        Close();
+        m_pData = std::exchange(aRhs.m_pData, nullptr);
+        m_size = std::exchange(aRhs.m_size, 0);
+    }
+
+    return *this;
+}
+
+bool MappedFile::Open(const std::filesystem::path& acPath) noexcept
+{
+    Close();
+
+    // The mapping keeps its own reference to the file, so the handles can be closed as soon as the view exists
+#ifdef _WIN32
+    HANDLE file = CreateFileW(acPath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping)
+        return false;
+
+    void* pView = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!pView)
+        return false;
+
+    m_pData = static_cast<const uint8_t*>(pView);
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    const int file = open(acPath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file < 0)
+        return false;
+
+    struct stat fileStat{};
+    if (fstat(file, &fileStat) != 0 || fileStat.st_size == 0)
+    {
+        close(file);
+        return false;
+    }
+
+    void* pView = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (pView == MAP_FAILED)
+        return false;
+
+    // Indexing walks the file front to back, let the kernel read ahead aggressively
+    madvise(pView, static_cast<size_t>(fileStat.st_size), MADV_SEQUENTIAL);
+
+    m_pData = static_cast<const uint8_t*>(pView);
+    m_size = static_cast<size_t>(fileStat.st_size);
+#endif
+
+    return true;
+}
+
+void MappedFile::Close() noexcept
+{
+    if (!m_pData)
+        return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(m_pData);
+#else
+    munmap(const_cast<uint8_t*>(m_pData), m_size);
+#endif
+
+    m_pData = nullptr;
+    m_size = 0;
+}
+} // namespace ESLoader
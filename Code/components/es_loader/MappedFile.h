@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+
+namespace ESLoader
+{
+/**
+* @brief Read only memory mapping of a whole file.
+*
+* Pages are loaded by the OS on first access and shared with the file cache, so mapping
+* a plugin costs address space rather than heap memory.
+*/
+class MappedFile
+{
+  public:
+    MappedFile() = default;
+    ~MappedFile() noexcept;
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& aRhs) noexcept;
+    MappedFile& operator=(MappedFile&& aRhs) noexcept;
+
+    bool Open(const std::filesystem::path& acPath) noexcept;
+    void Close() noexcept;
+
+    [[nodiscard]] bool IsOpen() const noexcept
+    {
+        return m_pData != nullptr;
+    }
+    [[nodiscard]] const uint8_t* GetData() const noexcept
+    {
+        return m_pData;
+    }
+    [[nodiscard]] size_t GetSize() const noexcept
+    {
+        return m_size;
+    }
+
+  private:
+    const uint8_t* m_pData = nullptr;
+    size_t m_size = 0;
+};
+} // namespace ESLoader
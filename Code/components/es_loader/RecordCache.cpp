@@ -0,0 +1,241 @@
+#include "RecordCache.h"
+
+#include <cstring>
+#include <fstream>
+
+namespace ESLoader
+{
+namespace
+{
+constexpr char kMagic[4] = {'T', 'P', 'R', 'C'};
+
+struct CacheReader
+{
+    template <class T> bool Read(T& aValue) noexcept
+    {
+        return ReadArray(&aValue, 1);
+    }
+
+    template <class T> bool ReadArray(T* apValues, size_t aCount) noexcept
+    {
+        if ((m_size - m_position) / sizeof(T) < aCount)
+            return false;
+
+        std::memcpy(apValues, m_pData + m_position, aCount * sizeof(T));
+        m_position += aCount * sizeof(T);
+        return true;
+    }
+
+    bool ReadString(String& aValue) noexcept
+    {
+        uint32_t length = 0;
+        if (!Read(length) || m_size - m_position < length)
+            return false;
+
+        aValue.assign(reinterpret_cast<const char*>(m_pData + m_position), length);
+        m_position += length;
+        return true;
+    }
+
+    // Whether aCount entries of aEntrySize bytes could still be read, checked before sizing anything after a count
+    [[nodiscard]] bool CanRead(uint64_t aCount, size_t aEntrySize) const noexcept
+    {
+        return aCount <= (m_size - m_position) / aEntrySize;
+    }
+
+    const uint8_t* m_pData;
+    size_t m_size;
+    size_t m_position = 0;
+};
+
+template <class T> void Write(std::ofstream& aFile, const T& acValue) noexcept
+{
+    aFile.write(reinterpret_cast<const char*>(&acValue), sizeof(T));
+}
+
+template <class T> void WriteArray(std::ofstream& aFile, const Vector<T>& acValues) noexcept
+{
+    aFile.write(reinterpret_cast<const char*>(acValues.data()), acValues.size() * sizeof(T));
+}
+
+void WriteString(std::ofstream& aFile, const String& acValue) noexcept
+{
+    Write(aFile, static_cast<uint32_t>(acValue.size()));
+    aFile.write(acValue.data(), acValue.size());
+}
+} // namespace
+
+RecordCache::PluginStamp RecordCache::MakeStamp(const String& acFilename, const fs::path& acPath) noexcept
+{
+    PluginStamp stamp{acFilename};
+    if (acPath.empty())
+        return stamp;
+
+    std::error_code ec;
+    stamp.m_size = fs::file_size(acPath, ec);
+    if (ec)
+        stamp.m_size = 0;
+
+    const auto modifiedTime = fs::last_write_time(acPath, ec);
+    if (!ec)
+        stamp.m_modifiedTime = static_cast<int64_t>(modifiedTime.time_since_epoch().count());
+
+    return stamp;
+}
+
+UniquePtr<RecordCollection> RecordCache::Load(const fs::path& acCachePath, const Vector<PluginStamp>& acLoadOrder,
+                                              const Vector<fs::path>& acPluginPaths) noexcept
+{
+    std::error_code ec;
+    if (!fs::exists(acCachePath, ec))
+        return nullptr;
+
+    MappedFile cacheFile;
+    if (!cacheFile.Open(acCachePath))
+        return nullptr;
+
+    CacheReader reader{cacheFile.GetData(), cacheFile.GetSize()};
+
+    char magic[4]{};
+    uint32_t version = 0;
+    uint32_t loadOrderCount = 0;
+    uint32_t pluginCount = 0;
+    uint64_t recordCount = 0;
+    if (!reader.Read(magic) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 || !reader.Read(version) || version != kVersion)
+        return nullptr;
+
+    if (!reader.Read(loadOrderCount) || !reader.Read(pluginCount) || !reader.Read(recordCount) || loadOrderCount != acLoadOrder.size())
+        return nullptr;
+
+    for (const PluginStamp& stamp : acLoadOrder)
+    {
+        PluginStamp cached;
+        if (!reader.ReadString(cached.m_filename) || !reader.Read(cached.m_size) || !reader.Read(cached.m_modifiedTime))
+            return nullptr;
+
+        if (cached.m_filename != stamp.m_filename || cached.m_size != stamp.m_size || cached.m_modifiedTime != stamp.m_modifiedTime)
+        {
+            spdlog::info("Record cache is stale, {} changed", stamp.m_filename);
+            return nullptr;
+        }
+    }
+
+    // Each plugin takes at least its slot and prefix count, and maps to a distinct slot of the load order
+    if (pluginCount > acPluginPaths.size() || !reader.CanRead(pluginCount, 2 * sizeof(uint32_t)))
+        return nullptr;
+
+    auto recordCollection = MakeUnique<RecordCollection>();
+    recordCollection->m_plugins.reserve(pluginCount);
+
+    for (uint32_t i = 0; i < pluginCount; ++i)
+    {
+        uint32_t slot = 0;
+        uint32_t prefixCount = 0;
+        if (!reader.Read(slot) || slot >= acPluginPaths.size() || !reader.Read(prefixCount) ||
+            !reader.CanRead(prefixCount, sizeof(uint8_t) + sizeof(uint32_t)))
+            return nullptr;
+
+        RecordCollection::Plugin plugin{};
+        for (uint32_t j = 0; j < prefixCount; ++j)
+        {
+            uint8_t parentId = 0;
+            uint32_t prefix = 0;
+            if (!reader.Read(parentId) || !reader.Read(prefix))
+                return nullptr;
+
+            plugin.m_parentToFormIdPrefix[parentId] = prefix;
+        }
+
+        if (!plugin.m_file.Open(acPluginPaths[slot]))
+            return nullptr;
+
+        recordCollection->m_plugins.push_back(std::move(plugin));
+    }
+
+    // The index is stored exactly as it lives in memory, sorted form ids followed by their locations
+    auto& formIds = recordCollection->m_formIds;
+    auto& records = recordCollection->m_records;
+    if (!reader.CanRead(recordCount, sizeof(uint32_t) + sizeof(RecordCollection::RecordEntry)))
+        return nullptr;
+
+    formIds.resize(recordCount);
+    records.resize(recordCount);
+    if (!reader.ReadArray(formIds.data(), formIds.size()) || !reader.ReadArray(records.data(), records.size()))
+        return nullptr;
+
+    for (const auto& entry : records)
+    {
+        if (entry.m_pluginIndex >= pluginCount || entry.m_offset + sizeof(Record) > recordCollection->m_plugins[entry.m_pluginIndex].m_file.GetSize())
+            return nullptr;
+    }
+
+    return recordCollection;
+}
+
+bool RecordCache::Save(const fs::path& acCachePath, const Vector<PluginStamp>& acLoadOrder, const Vector<uint32_t>& acPluginSlots,
+                       const RecordCollection& acRecordCollection) noexcept
+{
+    std::error_code ec;
+    fs::create_directories(acCachePath.parent_path(), ec);
+
+    // Written next to the real file and swapped in, a crash mid write must not leave a damaged cache behind
+    fs::path tempPath = acCachePath;
+    tempPath += ".tmp";
+
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (file.fail())
+        {
+            spdlog::warn("Failed to create record cache {}", tempPath.string());
+            return false;
+        }
+
+        const auto& plugins = acRecordCollection.m_plugins;
+
+        file.write(kMagic, sizeof(kMagic));
+        Write(file, kVersion);
+        Write(file, static_cast<uint32_t>(acLoadOrder.size()));
+        Write(file, static_cast<uint32_t>(plugins.size()));
+        Write(file, static_cast<uint64_t>(acRecordCollection.m_formIds.size()));
+
+        for (const PluginStamp& stamp : acLoadOrder)
+        {
+            WriteString(file, stamp.m_filename);
+            Write(file, stamp.m_size);
+            Write(file, stamp.m_modifiedTime);
+        }
+
+        for (size_t i = 0; i < plugins.size(); ++i)
+        {
+            Write(file, acPluginSlots[i]);
+            Write(file, static_cast<uint32_t>(plugins[i].m_parentToFormIdPrefix.size()));
+            for (const auto& [parentId, prefix] : plugins[i].m_parentToFormIdPrefix)
+            {
+                Write(file, parentId);
+                Write(file, prefix);
+            }
+        }
+
+        WriteArray(file, acRecordCollection.m_formIds);
+        WriteArray(file, acRecordCollection.m_records);
+
+        if (file.fail())
+        {
+            spdlog::warn("Failed to write record cache {}", tempPath.string());
+            file.close();
+            fs::remove(tempPath, ec);
+            return false;
+        }
+    }
+
+    fs::rename(tempPath, acCachePath, ec);
+    if (ec)
+    {
+        spdlog::warn("Failed to replace record cache {}: {}", acCachePath.string(), ec.message());
+        fs::remove(tempPath, ec);
+        return false;
+    }
+
+    return true;
+}
+} // namespace ESLoader
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <RecordCollection.h>
+
+namespace fs = std::filesystem;
+
+namespace ESLoader
+{
+/**
+* @brief On disk snapshot of a record collection's index.
+*
+* Stores the record index of every indexed plugin along with its form id prefixes, so a restart with an
+* unchanged load order only has to map the plugins again instead of walking them. The snapshot is keyed by
+* the load order and each plugin's size and modification time, any difference makes it stale.
+*/
+struct RecordCache
+{
+    // Bump whenever the layout or the indexing rules change
+    static constexpr uint32_t kVersion = 2;
+
+    struct PluginStamp
+    {
+        String m_filename;
+        uint64_t m_size = 0;
+        int64_t m_modifiedTime = 0;
+    };
+
+    static PluginStamp MakeStamp(const String& acFilename, const fs::path& acPath) noexcept;
+
+    // Returns null if the cache is missing, stale or damaged. aPluginPaths is indexed like the load order.
+    static UniquePtr<RecordCollection> Load(const fs::path& acCachePath, const Vector<PluginStamp>& acLoadOrder,
+                                            const Vector<fs::path>& acPluginPaths) noexcept;
+    // aPluginSlots maps each plugin of the collection to its position in the load order
+    static bool Save(const fs::path& acCachePath, const Vector<PluginStamp>& acLoadOrder, const Vector<uint32_t>& acPluginSlots,
+                     const RecordCollection& acRecordCollection) noexcept;
+};
+} // namespace ESLoader
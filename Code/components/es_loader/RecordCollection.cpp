@@ -1,16 +1,156 @@
 #include "RecordCollection.h"
 
+#include <TESFile.h>
+
+#include <algorithm>
+
 namespace ESLoader
 {
+template <class T> bool RecordCollection::ParseRecord(uint32_t aFormId, T& aRecord) noexcept
+{
+    const RecordEntry* pEntry = FindRecord(aFormId);
+    if (!pEntry || pEntry->m_type != T::kType)
+        return false;
+
+    T* pRecord = static_cast<T*>(GetRecordHeader(*pEntry));
+    if (!pRecord)
+        return false;
+
+    auto& parentToFormIdPrefix = m_plugins[pEntry->m_pluginIndex].m_parentToFormIdPrefix;
+
+    aRecord.CopyRecordData(*pRecord);
+    aRecord.SetBaseId(TESFile::GetFormIdPrefix(pRecord->GetFormId(), parentToFormIdPrefix));
+    aRecord.ParseChunks(*pRecord, parentToFormIdPrefix);
+
+    return true;
+}
+
+template <class T> T& RecordCollection::GetRecord(Map<uint32_t, UniquePtr<T>>& aCache, uint32_t aFormId) noexcept
+{
+    const auto cached = aCache.find(aFormId);
+    if (cached != std::end(aCache))
+        return *cached->second;
+
+    // Unknown ids still get a default record, like the maps used to hand out
+    T& parsedRecord = *aCache.emplace(aFormId, MakeUnique<T>()).first->second;
+    ParseRecord(aFormId, parsedRecord);
+
+    return parsedRecord;
+}
+
+bool RecordCollection::GetNavMeshLocation(uint32_t aFormId, NAVM::Location& aLocation) const noexcept
+{
+    const RecordEntry* pEntry = FindRecord(aFormId);
+    if (!pEntry || pEntry->m_type != FormEnum::NAVM)
+        return false;
+
+    const Record* pRecord = GetRecordHeader(*pEntry);
+    if (!pRecord)
+        return false;
+
+    // The prefix map is only read, it is not const because the parsers share its type
+    auto& parentToFormIdPrefix = const_cast<Map<uint8_t, uint32_t>&>(m_plugins[pEntry->m_pluginIndex].m_parentToFormIdPrefix);
+    return NAVM::ReadLocation(*pRecord, parentToFormIdPrefix, aLocation);
+}
+
+bool RecordCollection::ParseNavMeshById(uint32_t aFormId, NAVM& aNavMesh) noexcept
+{
+    // Callers parse the same nav meshes again when they need them back
+    DecompressedRecordCache::Scope scope(m_decompressedCache);
+    return ParseRecord(aFormId, aNavMesh);
+}
+
 void RecordCollection::BuildReferences()
 {
-    for (auto& [_, navmesh] : m_navMeshes)
+    if (m_referencesBuilt)
+        return;
+
+    m_referencesBuilt = true;
+
+    for (size_t i = 0; i < m_records.size(); ++i)
     {
+        if (m_records[i].m_type != FormEnum::NAVM)
+            continue;
+
+        const NAVM& navmesh = GetNavMeshById(m_formIds[i]);
         if (navmesh.m_navMesh.m_worldSpaceId)
         {
-            auto& world = GetWorldById(navmesh.m_navMesh.m_worldSpaceId);
+            auto& world = GetRecord(m_worlds, navmesh.m_navMesh.m_worldSpaceId);
             world.m_navMeshRefs.push_back(&navmesh);
         }
     }
 }
+
+Vector<uint32_t> RecordCollection::GetFormIdsOfType(FormEnum aType) const noexcept
+{
+    Vector<uint32_t> formIds;
+    for (size_t i = 0; i < m_records.size(); ++i)
+    {
+        if (m_records[i].m_type == aType)
+            formIds.push_back(m_formIds[i]);
+    }
+
+    return formIds;
+}
+
+void RecordCollection::BuildIndex() noexcept
+{
+    // Records were merged in load order, a stable sort keeps the overriding one last within each form id
+    std::stable_sort(m_pendingRecords.begin(), m_pendingRecords.end(),
+                     [](const IndexedRecord& acLhs, const IndexedRecord& acRhs) { return acLhs.m_formId < acRhs.m_formId; });
+
+    m_formIds.clear();
+    m_records.clear();
+    m_formIds.reserve(m_pendingRecords.size());
+    m_records.reserve(m_pendingRecords.size());
+
+    for (size_t i = 0; i < m_pendingRecords.size(); ++i)
+    {
+        if (i + 1 < m_pendingRecords.size() && m_pendingRecords[i + 1].m_formId == m_pendingRecords[i].m_formId)
+            continue;
+
+        m_formIds.push_back(m_pendingRecords[i].m_formId);
+        m_records.push_back(m_pendingRecords[i].m_entry);
+    }
+
+    m_formIds.shrink_to_fit();
+    m_records.shrink_to_fit();
+    Vector<IndexedRecord>().swap(m_pendingRecords);
+}
+
+const RecordCollection::RecordEntry* RecordCollection::FindRecord(uint32_t aFormId) const noexcept
+{
+    const auto formId = std::lower_bound(m_formIds.begin(), m_formIds.end(), aFormId);
+    if (formId == m_formIds.end() || *formId != aFormId)
+        return nullptr;
+
+    return &m_records[formId - m_formIds.begin()];
+}
+
+Record* RecordCollection::GetRecordHeader(const RecordEntry& acEntry) const noexcept
+{
+    // Entries loaded from the cache only had their header bounds checked, the rest is checked here on first use
+    // rather than walking every record of every plugin at startup
+    const auto& cFile = m_plugins[acEntry.m_pluginIndex].m_file;
+    if (acEntry.m_offset + sizeof(Record) > cFile.GetSize())
+        return nullptr;
+
+    // The mapping is read only, records are never written through this pointer
+    const uint8_t* pData = cFile.GetData() + acEntry.m_offset;
+    auto* pRecord = reinterpret_cast<Record*>(const_cast<uint8_t*>(pData));
+
+    if (pRecord->GetType() != acEntry.m_type || acEntry.m_offset + sizeof(Record) + pRecord->GetDataSize() > cFile.GetSize())
+        return nullptr;
+
+    return pRecord;
+}
+
+// The getters are inline in the header, so every record type needs its parser instantiated here
+template REFR& RecordCollection::GetRecord(Map<uint32_t, UniquePtr<REFR>>&, uint32_t) noexcept;
+template CLMT& RecordCollection::GetRecord(Map<uint32_t, UniquePtr<CLMT>>&, uint32_t) noexcept;
+template NPC& RecordCollection::GetRecord(Map<uint32_t, UniquePtr<NPC>>&, uint32_t) noexcept;
+template CONT& RecordCollection::GetRecord(Map<uint32_t, UniquePtr<CONT>>&, uint32_t) noexcept;
+template GMST& RecordCollection::GetRecord(Map<uint32_t, UniquePtr<GMST>>&, uint32_t) noexcept;
+template WRLD& RecordCollection::GetRecord(Map<uint32_t, UniquePtr<WRLD>>&, uint32_t) noexcept;
+template NAVM& RecordCollection::GetRecord(Map<uint32_t, UniquePtr<NAVM>>&, uint32_t) noexcept;
 } // namespace ESLoader
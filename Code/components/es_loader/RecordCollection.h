@@ -1,5 +1,9 @@
 #pragma once
 
+#include "MappedFile.h"
+
+#include "Records/DecompressedRecordCache.h"
+
 #include "Records/CLMT.h"
 #include "Records/CONT.h"
 #include "Records/GMST.h"
@@ -10,67 +14,133 @@
 
 namespace ESLoader
 {
+// Records are indexed straight from the mapped plugin files and only parsed the first time they are requested.
+// The index is a sorted form id array with the record locations in a parallel array, 16 bytes per record.
+// Parsed records are cached, references returned by the getters stay valid for the lifetime of the collection. Those
+// are inflated once and dropped, only records parsed into caller owned copies go through the inflated data cache.
+// Not thread safe.
 struct RecordCollection
 {
     friend class TESFile;
+    friend struct RecordCache;
 
     FormEnum GetFormType(uint32_t aFormId) const noexcept
     {
-        auto record = m_allRecords.find(aFormId);
-        if (record == std::end(m_allRecords))
+        const RecordEntry* pEntry = FindRecord(aFormId);
+        if (!pEntry)
         {
             spdlog::error("Record not found for form id {:X}", aFormId);
             return FormEnum::EMPTY_ID;
         }
 
-        return record->second.GetType();
+        return pEntry->m_type;
     }
 
     bool HasAnyRecords() const noexcept
     {
-        return m_allRecords.size();
+        return !m_formIds.empty();
+    }
+
+    size_t GetRecordCount() const noexcept
+    {
+        return m_formIds.size();
     }
 
+    // Form ids of the winning records of one type, in ascending order
+    Vector<uint32_t> GetFormIdsOfType(FormEnum aType) const noexcept;
+
     REFR& GetObjectRefById(uint32_t aFormId) noexcept
     {
-        return m_objectReferences[aFormId];
+        return GetRecord(m_objectReferences, aFormId);
     }
     CLMT& GetClimateById(uint32_t aFormId) noexcept
     {
-        return m_climates[aFormId];
+        return GetRecord(m_climates, aFormId);
     }
     NPC& GetNpcById(uint32_t aFormId) noexcept
     {
-        return m_npcs[aFormId];
+        return GetRecord(m_npcs, aFormId);
     }
     CONT& GetContainerById(uint32_t aFormId) noexcept
     {
-        return m_containers[aFormId];
+        return GetRecord(m_containers, aFormId);
     }
     GMST& GetGameSettingById(uint32_t aFormId) noexcept
     {
-        return m_gameSettings[aFormId];
+        return GetRecord(m_gameSettings, aFormId);
     }
     WRLD& GetWorldById(uint32_t aFormId) noexcept
     {
-        return m_worlds[aFormId];
+        // Worlds need every nav mesh parsed to know their nav mesh refs
+        BuildReferences();
+        return GetRecord(m_worlds, aFormId);
+    }
+    // Same record, but m_navMeshRefs is only filled once GetWorldById has been called
+    WRLD& GetWorldWithoutReferencesById(uint32_t aFormId) noexcept
+    {
+        return GetRecord(m_worlds, aFormId);
     }
     NAVM& GetNavMeshById(uint32_t aFormId) noexcept
     {
-        return m_navMeshes[aFormId];
+        return GetRecord(m_navMeshes, aFormId);
     }
+    // World space or cell of a nav mesh read straight from its record, nothing is parsed or cached
+    bool GetNavMeshLocation(uint32_t aFormId, NAVM::Location& aLocation) const noexcept;
+    // Parses a nav mesh into a record owned by the caller, for data converted once and not worth keeping around
+    bool ParseNavMeshById(uint32_t aFormId, NAVM& aNavMesh) noexcept;
 
     void BuildReferences();
+    // Sorts the records merged in load order into the lookup arrays, keeping the last one of each form id
+    void BuildIndex() noexcept;
 
 private:
-    Map<uint32_t, Record> m_allRecords{};
-    Map<uint32_t, REFR> m_objectReferences{};
-    Map<uint32_t, CLMT> m_climates{};
-    Map<uint32_t, NPC> m_npcs{};
-    Map<uint32_t, CONT> m_containers{};
-    Map<uint32_t, GMST> m_gameSettings{};
-    Map<uint32_t, WRLD> m_worlds{};
-    Map<uint32_t, NAVM> m_navMeshes{};
+    // Location of the winning record for a form id, the type is kept here so filtering never touches the mapping
+    struct RecordEntry
+    {
+        FormEnum m_type;
+        uint32_t m_offset;
+        uint32_t m_pluginIndex;
+    };
+
+    static_assert(sizeof(RecordEntry) == 12);
+
+    struct IndexedRecord
+    {
+        uint32_t m_formId;
+        RecordEntry m_entry;
+    };
+
+    struct Plugin
+    {
+        MappedFile m_file;
+        Map<uint8_t, uint32_t> m_parentToFormIdPrefix;
+    };
+
+    template <class T> T& GetRecord(Map<uint32_t, UniquePtr<T>>& aCache, uint32_t aFormId) noexcept;
+    // False if no record of that type exists, aRecord is left untouched then
+    template <class T> bool ParseRecord(uint32_t aFormId, T& aRecord) noexcept;
+
+    [[nodiscard]] const RecordEntry* FindRecord(uint32_t aFormId) const noexcept;
+    // Null if the record in the plugin doesn't match the entry, a stale or damaged cache can point anywhere
+    [[nodiscard]] Record* GetRecordHeader(const RecordEntry& acEntry) const noexcept;
+
+    Vector<Plugin> m_plugins{};
+    Vector<IndexedRecord> m_pendingRecords{};
+    Vector<uint32_t> m_formIds{};
+    Vector<RecordEntry> m_records{};
+    bool m_referencesBuilt = false;
+
+    // Parsed records live behind pointers, the maps move their values when they grow
+    Map<uint32_t, UniquePtr<REFR>> m_objectReferences{};
+    Map<uint32_t, UniquePtr<CLMT>> m_climates{};
+    Map<uint32_t, UniquePtr<NPC>> m_npcs{};
+    Map<uint32_t, UniquePtr<CONT>> m_containers{};
+    Map<uint32_t, UniquePtr<GMST>> m_gameSettings{};
+    Map<uint32_t, UniquePtr<WRLD>> m_worlds{};
+    Map<uint32_t, UniquePtr<NAVM>> m_navMeshes{};
+
+    // Keyed by record address, which stays valid as long as the plugins are mapped
+    DecompressedRecordCache m_decompressedCache{};
 };
 
 } // namespace ESLoader
@@ -178,19 +178,20 @@ DNAM::DNAM(Buffer::Reader& aReader)
     aReader.ReadBytes(reinterpret_cast<uint8_t*>(&m_waterLevel), 4);
 }
 
-NVNM::NVNM(Buffer::Reader& aReader)
+NVNM::NVNM(Buffer::Reader& aReader, Map<uint8_t, uint32_t>& aParentToFormIdPrefix)
 {
     aReader.ReadBytes(reinterpret_cast<uint8_t*>(&m_unknown), 4);
     aReader.ReadBytes(reinterpret_cast<uint8_t*>(&m_locactionMarker), 4);
     aReader.ReadBytes(reinterpret_cast<uint8_t*>(&m_worldSpaceId), 4);
+    // A null world space means the nav mesh belongs to an interior cell, it must be tested before resolving
     if (m_worldSpaceId == 0)
     {
-        uint32_t id = 0;
-        aReader.ReadBytes(reinterpret_cast<uint8_t*>(&id), 4);
-        m_cellId = id;
+        m_cellId = ReadFormId(aReader, aParentToFormIdPrefix);
     }
     else
     {
+        m_worldSpaceId = (m_worldSpaceId & 0x00FFFFFF) + ESLoader::TESFile::GetFormIdPrefix(m_worldSpaceId, aParentToFormIdPrefix);
+
         int16_t tmp = 0;
         aReader.ReadBytes(reinterpret_cast<uint8_t*>(&tmp), 2);
         m_gridY = tmp;
@@ -220,7 +221,7 @@ NVNM::NVNM(Buffer::Reader& aReader)
     for (auto& connection : m_connections)
     {
         aReader.ReadBytes(reinterpret_cast<uint8_t*>(&connection.m_unk), sizeof(connection.m_unk));
-        aReader.ReadBytes(reinterpret_cast<uint8_t*>(&connection.m_navMeshId), sizeof(connection.m_navMeshId));
+        connection.m_navMeshId = ReadFormId(aReader, aParentToFormIdPrefix);
         aReader.ReadBytes(reinterpret_cast<uint8_t*>(&connection.tri), sizeof(connection.tri));
     }
 
@@ -231,7 +232,7 @@ NVNM::NVNM(Buffer::Reader& aReader)
     {
         aReader.ReadBytes(reinterpret_cast<uint8_t*>(&doorTri.tri), sizeof(doorTri.tri));
         aReader.ReadBytes(reinterpret_cast<uint8_t*>(&doorTri.m_unk), sizeof(doorTri.m_unk));
-        aReader.ReadBytes(reinterpret_cast<uint8_t*>(&doorTri.m_doorId), sizeof(doorTri.m_doorId));
+        doorTri.m_doorId = ReadFormId(aReader, aParentToFormIdPrefix);
     }
 
     int32_t coverTriangleCount = 0;
@@ -337,8 +337,11 @@ struct NVNM
     NVNM()
     {
     }
-    NVNM(Buffer::Reader& aReader);
+    NVNM(Buffer::Reader& aReader, TiltedPhoques::Map<uint8_t, uint32_t>& aParentToFormIdPrefix);
 
+    // Edge i runs from vertex i to vertex i + 1, its value is the neighbour triangle in this nav mesh,
+    // or an index in m_connections when the matching edge link flag is set in m_coverMarker, which holds the
+    // triangle flags. -1 means the edge is a border.
     struct Tri
     {
         int16_t m_vertex0;
@@ -351,6 +354,8 @@ struct NVNM
 
         int16_t m_coverMarker;
         int16_t m_coverFlags;
+
+        static constexpr int16_t kEdgeLinkFlags[3] = {0x1, 0x2, 0x4};
     };
 
     struct Connection
@@ -0,0 +1,99 @@
+#include "DecompressedRecordCache.h"
+
+#include "Record.h"
+
+#include <cstring>
+
+namespace
+{
+thread_local DecompressedRecordCache* s_pCurrent = nullptr;
+}
+
+DecompressedRecordCache::Scope::Scope(DecompressedRecordCache& aCache) noexcept
+    : m_pPrevious(s_pCurrent)
+{
+    s_pCurrent = &aCache;
+}
+
+DecompressedRecordCache::Scope::~Scope() noexcept
+{
+    s_pCurrent = m_pPrevious;
+}
+
+DecompressedRecordCache* DecompressedRecordCache::GetCurrent() noexcept
+{
+    return s_pCurrent;
+}
+
+std::shared_ptr<Buffer> DecompressedRecordCache::Inflate(const Record& acRecord) noexcept
+{
+    // Compressed data starts with the inflated size
+    if (acRecord.GetDataSize() < sizeof(uint32_t))
+        return nullptr;
+
+    const uint8_t* pData = reinterpret_cast<const uint8_t*>(&acRecord) + sizeof(Record);
+
+    uint32_t decompressedSize = 0;
+    std::memcpy(&decompressedSize, pData, sizeof(decompressedSize));
+
+    auto pDecompressed = std::make_shared<Buffer>(decompressedSize);
+    if (!Record::DecompressChunkData(pData + sizeof(uint32_t), acRecord.GetDataSize() - sizeof(uint32_t), pDecompressed->GetWriteData(),
+                                     pDecompressed->GetSize()))
+    {
+        return nullptr;
+    }
+
+    return pDecompressed;
+}
+
+std::shared_ptr<Buffer> DecompressedRecordCache::Acquire(const Record& acRecord) noexcept
+{
+    const auto cached = m_lookup.find(&acRecord);
+    if (cached != std::end(m_lookup))
+    {
+        m_entries.splice(m_entries.begin(), m_entries, cached->second);
+        return cached->second->m_pData;
+    }
+
+    auto pDecompressed = Inflate(acRecord);
+    if (!pDecompressed)
+        return nullptr;
+
+    // Bigger than the whole budget, hand it out without caching it
+    const size_t decompressedSize = pDecompressed->GetSize();
+    if (decompressedSize > m_budget)
+        return pDecompressed;
+
+    m_entries.push_front({&acRecord, pDecompressed});
+    m_lookup[&acRecord] = m_entries.begin();
+    m_size += decompressedSize;
+
+    Evict();
+
+    return pDecompressed;
+}
+
+void DecompressedRecordCache::SetBudget(size_t aBytes) noexcept
+{
+    m_budget = aBytes;
+    Evict();
+}
+
+void DecompressedRecordCache::Clear() noexcept
+{
+    m_entries.clear();
+    m_lookup.clear();
+    m_size = 0;
+}
+
+void DecompressedRecordCache::Evict() noexcept
+{
+    while (m_size > m_budget && !m_entries.empty())
+    {
+        const Entry& entry = m_entries.back();
+
+        m_size -= entry.m_pData->GetSize();
+        m_lookup.erase(entry.m_pRecord);
+        m_entries.pop_back();
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <list>
+#include <memory>
+
+class Record;
+
+/**
+* @brief Bounded LRU of inflated record data.
+*
+* Each record collection owns one, so cached data never outlives the plugin mappings it was inflated from. Parsing
+* goes through it only while a Scope makes it current on the thread, records parsed once and kept as parsed data
+* are inflated without it. The data handed out stays alive while the caller holds it even if evicted.
+*/
+class DecompressedRecordCache
+{
+  public:
+    static constexpr size_t kDefaultBudget = 32 * 1024 * 1024;
+
+    // Makes a cache current on this thread for the lifetime of the scope
+    struct Scope
+    {
+        explicit Scope(DecompressedRecordCache& aCache) noexcept;
+        ~Scope() noexcept;
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+      private:
+        DecompressedRecordCache* m_pPrevious;
+    };
+
+    // Null outside of a Scope
+    [[nodiscard]] static DecompressedRecordCache* GetCurrent() noexcept;
+    // Inflates the record data without caching it, null on failure
+    [[nodiscard]] static std::shared_ptr<Buffer> Inflate(const Record& acRecord) noexcept;
+
+    // Null if the record data could not be inflated
+    [[nodiscard]] std::shared_ptr<Buffer> Acquire(const Record& acRecord) noexcept;
+
+    void SetBudget(size_t aBytes) noexcept;
+    void Clear() noexcept;
+
+    [[nodiscard]] size_t GetSize() const noexcept
+    {
+        return m_size;
+    }
+
+  private:
+    struct Entry
+    {
+        const Record* m_pRecord;
+        std::shared_ptr<Buffer> m_pData;
+    };
+
+    void Evict() noexcept;
+
+    // Most recently used first
+    std::list<Entry> m_entries{};
+    Map<const Record*, std::list<Entry>::iterator> m_lookup{};
+    size_t m_size = 0;
+    size_t m_budget = kDefaultBudget;
+};
@@ -2,14 +2,65 @@
 
 #include <ESLoader.h>
 
+#include <cstring>
+
 void NAVM::ParseChunks(NAVM &aSourceRecord, Map<uint8_t, uint32_t>& aParentToFormIdPrefix) noexcept
 {
     aSourceRecord.IterateChunks([&](ChunkId aChunkId, Buffer::Reader& aReader) { 
         switch (aChunkId)
         {
         case ChunkId::NVNM_ID:
-            m_navMesh = Chunks::NVNM{aReader};
+            m_navMesh = Chunks::NVNM{aReader, aParentToFormIdPrefix};
             break;
         }
     });
 }
+
+bool NAVM::ReadLocation(const Record& acSourceRecord, Map<uint8_t, uint32_t>& aParentToFormIdPrefix, Location& aLocation) noexcept
+{
+    // NVNM is the first chunk, behind the XXXX chunk holding its size when it is large
+    uint8_t data[48];
+    const size_t size = acSourceRecord.ReadDataPrefix(data, sizeof(data));
+
+    size_t position = 0;
+    while (position + sizeof(Record::Chunk) <= size)
+    {
+        Record::Chunk chunk;
+        std::memcpy(&chunk, data + position, sizeof(chunk));
+        position += sizeof(chunk);
+
+        if (chunk.m_chunkId == ChunkId::XXXX_ID)
+        {
+            position += sizeof(uint32_t);
+            continue;
+        }
+
+        // Unknown, location marker, world space, then either the cell or the grid
+        if (chunk.m_chunkId != ChunkId::NVNM_ID || position + 16 > size)
+            return false;
+
+        ViewBuffer buffer(data + position, size - position);
+        Buffer::Reader reader(&buffer);
+        reader.Advance(8);
+
+        uint32_t formId = 0;
+        reader.ReadBytes(reinterpret_cast<uint8_t*>(&formId), 4);
+
+        aLocation = {};
+        if (formId == 0)
+        {
+            reader.ReadBytes(reinterpret_cast<uint8_t*>(&formId), 4);
+            aLocation.m_cellId = (formId & 0x00FFFFFF) + ESLoader::TESFile::GetFormIdPrefix(formId, aParentToFormIdPrefix);
+        }
+        else
+        {
+            aLocation.m_worldSpaceId = (formId & 0x00FFFFFF) + ESLoader::TESFile::GetFormIdPrefix(formId, aParentToFormIdPrefix);
+            reader.ReadBytes(reinterpret_cast<uint8_t*>(&aLocation.m_gridY), 2);
+            reader.ReadBytes(reinterpret_cast<uint8_t*>(&aLocation.m_gridX), 2);
+        }
+
+        return true;
+    }
+
+    return false;
+}
@@ -9,7 +9,19 @@ class NAVM : public Record
 public:
     static constexpr FormEnum kType = FormEnum::NAVM;
 
+    // Where a nav mesh lives, the cell is only set for interiors and the grid only for exteriors
+    struct Location
+    {
+        uint32_t m_worldSpaceId;
+        uint32_t m_cellId;
+        int16_t m_gridX;
+        int16_t m_gridY;
+    };
+
     Chunks::NVNM m_navMesh;
 
     void ParseChunks(NAVM& aSourceRecord, TiltedPhoques::Map<uint8_t, uint32_t>& aParentToFormIdPrefix) noexcept;
+    // Reads the location from the first bytes of the NVNM chunk, without inflating or parsing the rest of the record
+    static bool ReadLocation(const Record& acSourceRecord, TiltedPhoques::Map<uint8_t, uint32_t>& aParentToFormIdPrefix,
+                             Location& aLocation) noexcept;
 };
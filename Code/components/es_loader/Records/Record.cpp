@@ -1,7 +1,10 @@
 #include "Record.h"
+#include "DecompressedRecordCache.h"
 
 #include <zlib.h>
 
+#include <cstring>
+
 void Record::CopyRecordData(Record& aRhs)
 {
     m_formType = aRhs.m_formType;
@@ -21,20 +24,20 @@ void Record::SetBaseId(uint32_t aBaseId)
 
 void Record::IterateChunks(const std::function<void(ChunkId, Buffer::Reader&)>& aCallback)
 {
-    Buffer buffer(reinterpret_cast<uint8_t*>(this) + sizeof(Record), m_dataSize);
+    // The record lives in the plugin mapping, read it in place
+    ViewBuffer buffer(reinterpret_cast<uint8_t*>(this) + sizeof(Record), m_dataSize);
     Buffer::Reader reader(&buffer);
 
-    Buffer pDecompressed;
+    // Held for the whole iteration, the cache may evict it in the meantime
+    std::shared_ptr<Buffer> pDecompressed;
     if (Compressed())
     {
-        uint32_t size = 0;
-        reader.ReadBytes(reinterpret_cast<uint8_t*>(&size), 4);
-        pDecompressed.Resize(size);
-        const uint32_t fieldSize = m_dataSize - 4;
-
-        DecompressChunkData(reader.GetDataAtPosition(), fieldSize, pDecompressed.GetWriteData(), pDecompressed.GetSize());
+        auto* pCache = DecompressedRecordCache::GetCurrent();
+        pDecompressed = pCache ? pCache->Acquire(*this) : DecompressedRecordCache::Inflate(*this);
+        if (!pDecompressed)
+            return;
 
-        reader = Buffer::Reader(&pDecompressed);
+        reader = Buffer::Reader(pDecompressed.get());
     }
 
     uint32_t largeDataSize = 0;
@@ -67,24 +70,100 @@ void Record::IterateChunks(const std::function<void(ChunkId, Buffer::Reader&)>&
     }
 }
 
-void Record::DecompressChunkData(const void* apCompressedData, size_t aCompressedSize, void* apDecompressedData, size_t aDecompressedSize)
+namespace
+{
+// One stream per thread, reset between records instead of paying inflateInit/inflateEnd every time
+z_stream* GetInflater() noexcept
+{
+    struct Inflater
+    {
+        Inflater() noexcept
+        {
+            m_stream.zalloc = Z_NULL;
+            m_stream.zfree = Z_NULL;
+            m_stream.opaque = Z_NULL;
+            m_ready = inflateInit(&m_stream) == Z_OK;
+        }
+        ~Inflater() noexcept
+        {
+            if (m_ready)
+                inflateEnd(&m_stream);
+        }
+
+        z_stream m_stream{};
+        bool m_ready = false;
+    };
+
+    thread_local Inflater s_inflater;
+    if (!s_inflater.m_ready)
+    {
+        spdlog::error("Failed to initialize zlib stream.");
+        return nullptr;
+    }
+
+    inflateReset(&s_inflater.m_stream);
+    return &s_inflater.m_stream;
+}
+} // namespace
+
+bool Record::DecompressChunkData(const void* apCompressedData, size_t aCompressedSize, void* apDecompressedData, size_t aDecompressedSize)
 {
-    z_stream compressionStream;
-    compressionStream.next_in = (Bytef*)apCompressedData;
-    compressionStream.avail_in = (uInt)(aCompressedSize);
-    compressionStream.next_out = (Bytef*)apDecompressedData;
-    compressionStream.avail_out = (uInt)aDecompressedSize;
-    compressionStream.zalloc = Z_NULL;
-    compressionStream.zfree = Z_NULL;
-    compressionStream.opaque = Z_NULL;
-
-    inflateInit(&compressionStream);
-    int res = inflate(&compressionStream, Z_NO_FLUSH);
-    if (res < Z_OK)
+    z_stream* pStream = GetInflater();
+    if (!pStream)
+        return false;
+
+    pStream->next_in = (Bytef*)apCompressedData;
+    pStream->avail_in = (uInt)(aCompressedSize);
+    pStream->next_out = (Bytef*)apDecompressedData;
+    pStream->avail_out = (uInt)aDecompressedSize;
+
+    const int res = inflate(pStream, Z_FINISH);
+    if (res != Z_STREAM_END)
+    {
         spdlog::error("Failed to decompress chunk of data (inflate): {}.", res);
-    res = inflateEnd(&compressionStream);
-    if (res < Z_OK)
-        spdlog::error("Failed to decompress chunk of data: {}", res);
+        return false;
+    }
+
+    return true;
+}
+
+size_t Record::ReadDataPrefix(uint8_t* apData, size_t aSize) const noexcept
+{
+    const uint8_t* pData = reinterpret_cast<const uint8_t*>(this) + sizeof(Record);
+
+    if (!Compressed())
+    {
+        const size_t size = std::min<size_t>(aSize, m_dataSize);
+        std::memcpy(apData, pData, size);
+        return size;
+    }
+
+    // Compressed data starts with the inflated size
+    if (m_dataSize < sizeof(uint32_t))
+        return 0;
+
+    uint32_t decompressedSize = 0;
+    std::memcpy(&decompressedSize, pData, sizeof(decompressedSize));
+
+    z_stream* pStream = GetInflater();
+    if (!pStream)
+        return 0;
+
+    // Inflation stops as soon as the output is full, the rest of the stream is never touched
+    const size_t size = std::min<size_t>(aSize, decompressedSize);
+    pStream->next_in = (Bytef*)(pData + sizeof(uint32_t));
+    pStream->avail_in = (uInt)(m_dataSize - sizeof(uint32_t));
+    pStream->next_out = (Bytef*)apData;
+    pStream->avail_out = (uInt)size;
+
+    const int res = inflate(pStream, Z_SYNC_FLUSH);
+    if ((res != Z_OK && res != Z_STREAM_END) || pStream->avail_out != 0)
+    {
+        spdlog::error("Failed to decompress the start of record {:X} (inflate): {}.", m_formId, res);
+        return 0;
+    }
+
+    return size;
 }
 
 void Record::DiscoverChunks()
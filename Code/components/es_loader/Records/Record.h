@@ -28,7 +28,10 @@ public:
     void SetBaseId(uint32_t aBaseId);
 
     void IterateChunks(const std::function<void(ChunkId, Buffer::Reader&)>& aCallback);
-    void DecompressChunkData(const void* apCompressedData, size_t aCompressedSize, void* apDecompressedData, size_t aDecompressedSize);
+    static bool DecompressChunkData(const void* apCompressedData, size_t aCompressedSize, void* apDecompressedData, size_t aDecompressedSize);
+    // Copies the first bytes of the record data into apData, only inflating what is needed. Returns how many were copied,
+    // less than aSize if the data is shorter, 0 on failure.
+    size_t ReadDataPrefix(uint8_t* apData, size_t aSize) const noexcept;
 
     void DiscoverChunks();
 
@@ -32,6 +32,18 @@ void WRLD::ParseChunks(WRLD& aSourceRecord, Map<uint8_t, uint32_t>& aParentToFor
         case ChunkId::NAMA_ID:
             aReader.ReadBytes(reinterpret_cast<uint8_t*>(&m_lodMultiplier), sizeof(m_lodMultiplier));
             break;
+        case ChunkId::NAM0_ID: {
+            glm::vec2 bounds{};
+            aReader.ReadBytes(reinterpret_cast<uint8_t*>(&bounds), sizeof(bounds));
+            m_boundsMin = bounds;
+        }
+            break;
+        case ChunkId::NAM9_ID: {
+            glm::vec2 bounds{};
+            aReader.ReadBytes(reinterpret_cast<uint8_t*>(&bounds), sizeof(bounds));
+            m_boundsMax = bounds;
+        }
+            break;
         }
     });
 }
@@ -18,6 +18,9 @@ public:
     std::optional<uint32_t> m_parentId;
     uint32_t m_musicId;
     float m_lodMultiplier;
+    // Object bounds in game units, the worldspace's cells are all within them
+    std::optional<glm::vec2> m_boundsMin;
+    std::optional<glm::vec2> m_boundsMax;
 
     Vector<NAVM const*> m_navMeshRefs;
 
@@ -1,11 +1,10 @@
 #include "TESFile.h"
 
 #include <filesystem>
-#include <fstream>
 
 namespace ESLoader
 {
-TESFile::TESFile(Map<String, uint8_t> &aMasterFiles) : m_masterFiles(aMasterFiles)
+TESFile::TESFile(const Map<String, uint8_t> &aMasterFiles) : m_masterFiles(aMasterFiles)
 {
 }
 
@@ -25,38 +24,49 @@ bool TESFile::LoadFile(const std::filesystem::path& acPath) noexcept
 {
     m_filename = acPath.filename().string();
 
-    const uintmax_t fileSize = std::filesystem::file_size(acPath);
-    m_buffer.Resize(fileSize);
-
-    std::ifstream file(acPath, std::ios::binary);
-    if (file.fail())
+    if (!m_file.Open(acPath))
     {
-        spdlog::error("Failed to open plugin {}", m_filename);
+        spdlog::error("Failed to map plugin {}", m_filename);
         return false;
     }
 
-    file.read(reinterpret_cast<char*>(m_buffer.GetWriteData()), fileSize);
-
     return true;
 }
 
-bool TESFile::IndexRecords(RecordCollection& aRecordCollection) noexcept
+bool TESFile::IndexRecords() noexcept
 {
-    if (m_filename.size() == 0)
+    if (!m_file.IsOpen())
         return false;
 
-    Buffer::Reader reader(&m_buffer);
+    // Records are only read in place, the mapping itself is read only
+    ViewBuffer view(const_cast<uint8_t*>(m_file.GetData()), m_file.GetSize());
+    Buffer::Reader reader(&view);
 
     while (true)
     {
-        if (!ReadGroupOrRecord(reader, aRecordCollection))
+        if (!ReadGroupOrRecord(reader))
             break;
     }
 
     return true;
 }
 
-bool TESFile::ReadGroupOrRecord(Buffer::Reader& aReader, RecordCollection& aRecordCollection) noexcept
+void TESFile::MergeInto(RecordCollection& aRecordCollection) noexcept
+{
+    const uint32_t pluginIndex = static_cast<uint32_t>(aRecordCollection.m_plugins.size());
+
+    for (auto& record : m_indexedRecords)
+        record.m_entry.m_pluginIndex = pluginIndex;
+
+    // Later plugins override earlier ones once BuildIndex sorts the records
+    aRecordCollection.m_pendingRecords.insert(aRecordCollection.m_pendingRecords.end(), m_indexedRecords.begin(), m_indexedRecords.end());
+    Vector<RecordCollection::IndexedRecord>().swap(m_indexedRecords);
+
+    // The collection now points into the mapping, hand it over so it outlives this file
+    aRecordCollection.m_plugins.push_back({std::move(m_file), std::move(m_parentToFormIdPrefix)});
+}
+
+bool TESFile::ReadGroupOrRecord(Buffer::Reader& aReader) noexcept
 {
     if (aReader.Eof())
         return false;
@@ -74,16 +84,15 @@ bool TESFile::ReadGroupOrRecord(Buffer::Reader& aReader, RecordCollection& aReco
 
         while (aReader.GetBytePosition() < endOfGroup)
         {
-            ReadGroupOrRecord(aReader, aRecordCollection);
+            ReadGroupOrRecord(aReader);
         }
     }
     else // Records
     {
-        Record* pRecord = reinterpret_cast<Record*>(m_buffer.GetWriteData() + aReader.GetBytePosition());
+        Record* pRecord = reinterpret_cast<Record*>(aReader.GetDataAtPosition());
 
-        switch (pRecord->GetType())
+        if (pRecord->GetType() == FormEnum::TES4)
         {
-        case FormEnum::TES4: {
             TES4* pFileHeader = reinterpret_cast<TES4*>(pRecord);
 
             TES4 fileHeader;
@@ -93,60 +102,20 @@ bool TESFile::ReadGroupOrRecord(Buffer::Reader& aReader, RecordCollection& aReco
             uint8_t parentId = 0;
             for (const Chunks::MAST& master : fileHeader.m_masterFiles)
             {
-                m_parentToFormIdPrefix[parentId] = ((uint32_t)m_masterFiles[master.m_masterName]) << 24;
+                // Lookup only, the master list is shared between indexing threads
+                const auto masterFile = m_masterFiles.find(master.m_masterName);
+                const uint8_t masterId = masterFile != std::end(m_masterFiles) ? masterFile->second : 0;
+                m_parentToFormIdPrefix[parentId] = ((uint32_t)masterId) << 24;
                 parentId++;
             }
 
             m_parentToFormIdPrefix[parentId] = m_formIdPrefix;
-
-            break;
         }
-        // case FormEnum::ACHR:
-        case FormEnum::REFR: {
-            REFR parsedRecord = CopyAndParseRecord<REFR>(pRecord);
-            aRecordCollection.m_objectReferences[parsedRecord.GetFormId()] = parsedRecord;
-            break;
-        }
-        case FormEnum::CELL:
-            break;
-        case FormEnum::CLMT: {
-            CLMT parsedRecord = CopyAndParseRecord<CLMT>(pRecord);
-            aRecordCollection.m_climates[parsedRecord.GetFormId()] = parsedRecord;
-            break;
-        }
-        case FormEnum::NPC_: {
-            NPC parsedRecord = CopyAndParseRecord<NPC>(pRecord);
-            aRecordCollection.m_npcs[parsedRecord.GetFormId()] = parsedRecord;
-            break;
-        }
-        case FormEnum::CONT: {
-            CONT parsedRecord = CopyAndParseRecord<CONT>(pRecord);
-            aRecordCollection.m_containers[parsedRecord.GetFormId()] = parsedRecord;
-            break;
-        }
-        case FormEnum::GMST: {
-            GMST parsedRecord = CopyAndParseRecord<GMST>(pRecord);
-            aRecordCollection.m_gameSettings[parsedRecord.GetFormId()] = parsedRecord;
-            break;
-        }
-        case FormEnum::WRLD: {
-            WRLD parsedRecord = CopyAndParseRecord<WRLD>(pRecord);
-            aRecordCollection.m_worlds[parsedRecord.GetFormId()] = parsedRecord;
-        }
-        case FormEnum::NAVM: {
-            NAVM parsedRecord = CopyAndParseRecord<NAVM>(pRecord);
-            aRecordCollection.m_navMeshes[parsedRecord.GetFormId()] = parsedRecord;
-        }
-        }
-
-        // pRecord->DiscoverChunks();
-
-        if (pRecord->GetType() != FormEnum::TES4)
+        else
         {
-            Record record;
-            record.CopyRecordData(*pRecord);
-            record.SetBaseId(GetFormIdPrefix(pRecord->GetFormId(), m_parentToFormIdPrefix));
-            aRecordCollection.m_allRecords[pRecord->GetFormId()] = *pRecord;
+            const uint32_t formId = (pRecord->GetFormId() & 0x00FFFFFF) + GetFormIdPrefix(pRecord->GetFormId(), m_parentToFormIdPrefix);
+            const uint32_t offset = static_cast<uint32_t>(aReader.GetBytePosition());
+            m_indexedRecords.push_back({formId, {pRecord->GetType(), offset, 0}});
         }
 
         aReader.Advance(sizeof(Record) + size);
@@ -155,35 +124,6 @@ bool TESFile::ReadGroupOrRecord(Buffer::Reader& aReader, RecordCollection& aReco
     return true;
 }
 
-template <typename T>
-concept ExpectsGRUP = requires(T t)
-{
-    &T::ParseGRUP;
-};
-
-template <class T> T TESFile::CopyAndParseRecord(Record* pRecordHeader)
-{
-    T* pRecord = reinterpret_cast<T*>(pRecordHeader);
-
-    T parsedRecord;
-    parsedRecord.CopyRecordData(*pRecord);
-    parsedRecord.SetBaseId(TESFile::GetFormIdPrefix(pRecord->GetFormId(), m_parentToFormIdPrefix));
-    parsedRecord.ParseChunks(*pRecord, m_parentToFormIdPrefix);
-
-    // If the record expects a subgroup right after, parse it? Or do we not care since we load everything?
-    if constexpr (ExpectsGRUP<T>)
-    {
-        //    ParseGRUP(pRecord, parsedRecord);
-    }
-
-    return parsedRecord;
-}
-
-template <class T> void TESFile::ParseGRUP(Record* pRecordHeader, T& aRecord)
-{
-    // aRecord.ParseGRUP();
-}
-
 uint32_t TESFile::GetFormIdPrefix(uint32_t aFormId, Map<uint8_t, uint32_t>& aParentToFormIdPrefix) noexcept
 {
     auto baseId = (uint8_t)(aFormId >> 24);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <RecordCollection.h>
+#include <MappedFile.h>
 
 #include <Records/CLMT.h>
 #include <Records/GMST.h>
@@ -15,24 +16,23 @@ class TESFile
 {
   public:
     TESFile() = default;
-    TESFile(TiltedPhoques::Map<String, uint8_t> &aMasterFiles);
+    TESFile(const TiltedPhoques::Map<String, uint8_t> &aMasterFiles);
 
     void Setup(uint8_t aStandardId);
     void Setup(uint16_t aLiteId);
     bool LoadFile(const std::filesystem::path& acPath) noexcept;
-    bool IndexRecords(RecordCollection& aRecordCollection) noexcept;
+    // Indexes into this file's own shard, safe to run concurrently for different files
+    bool IndexRecords() noexcept;
+    // Hands the shard and the mapping over, plugins must be merged in load order for overrides to win
+    void MergeInto(RecordCollection& aRecordCollection) noexcept;
 
     [[nodiscard]] static uint32_t GetFormIdPrefix(uint32_t aFormId, TiltedPhoques::Map<uint8_t, uint32_t>& aParentToFormIdPrefix) noexcept;
 
   private:
-    bool ReadGroupOrRecord(Buffer::Reader& aReader, RecordCollection& aRecordCollection) noexcept;
-
-    template <class T> T CopyAndParseRecord(Record* pRecordHeader);
-
-    template <class T> void ParseGRUP(Record* pRecordHeader, T& aRecord);
+    bool ReadGroupOrRecord(Buffer::Reader& aReader) noexcept;
 
     String m_filename = "";
-    Buffer m_buffer{};
+    MappedFile m_file{};
 
     union {
         uint8_t m_standardId = 0;
@@ -40,8 +40,10 @@ class TESFile
     };
     uint32_t m_formIdPrefix = 0;
 
-    TiltedPhoques::Map<String, uint8_t> &m_masterFiles;
+    const TiltedPhoques::Map<String, uint8_t> &m_masterFiles;
     TiltedPhoques::Map<uint8_t, uint32_t> m_parentToFormIdPrefix{};
+    // In file order so later duplicates win when merged, the plugin index is only known once merged
+    Vector<RecordCollection::IndexedRecord> m_indexedRecords{};
 };
 
 } // namespace ESLoader
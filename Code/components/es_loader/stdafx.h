@@ -12,6 +12,7 @@
 #include <TiltedCore/Filesystem.hpp>
 #include <TiltedCore/Stl.hpp>
 #include <TiltedCore/Buffer.hpp>
+#include <TiltedCore/ViewBuffer.hpp>
 #include <TiltedCore/Serialization.hpp>
 #include <glm/glm.hpp>
 
@@ -8,4 +8,7 @@ unittest("ESLoader")
 	set_pcxxheader("stdafx.h")
 	add_headerfiles("stdafx.h", {prefixdir = "ESLoader"})
 	add_files("stdafx.cpp")
+	-- The tests generate their plugins with the benchmark's writer
+	add_includedirs("../../es_loader_bench")
+	add_files("../../es_loader_bench/SyntheticPlugin.cpp", "../../es_loader_bench/PluginWriter.cpp")
 	add_packages("zlib", "glm")
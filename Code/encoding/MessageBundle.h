@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Opcodes.h"
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+* @brief Several server messages sent to a client in a single packet.
+*
+* A bundle is the kServerMessageBundle opcode followed by the messages, each one prefixed by its size as a var int.
+* A message is laid out exactly like a packet holding only that message, opcode included, so it can be handed to
+* ServerMessageFactory::Extract as is. Bundles don't nest.
+*/
+struct MessageBundle
+{
+    // The opcode
+    static constexpr size_t kHeaderSize = 1;
+    // Var int of a 32 bit size
+    static constexpr size_t kMaxSizePrefix = 5;
+
+    [[nodiscard]] static bool IsBundle(const void* apData, size_t aSize) noexcept
+    {
+        return aSize >= kHeaderSize && *static_cast<const uint8_t*>(apData) == kServerMessageBundle;
+    }
+
+    // Writes the size prefix of a message at apData, which must have room for kMaxSizePrefix bytes, returns its length
+    static size_t WriteSize(uint8_t* apData, uint32_t aSize) noexcept
+    {
+        size_t length = 0;
+
+        do
+        {
+            uint8_t byte = aSize & 0x7F;
+            aSize >>= 7;
+            if (aSize)
+                byte |= 0x80;
+
+            apData[length++] = byte;
+        } while (aSize);
+
+        return length;
+    }
+
+    // Calls acFunctor(pData, size) for each message of the bundle, returns false if the bundle is malformed, the
+    // messages before the malformed one have been visited then.
+    template <class T> static bool ForEach(const void* apData, size_t aSize, const T& acFunctor)
+    {
+        const auto* pData = static_cast<const uint8_t*>(apData);
+        size_t position = kHeaderSize;
+
+        while (position < aSize)
+        {
+            uint32_t size = 0;
+            uint32_t shift = 0;
+            uint8_t byte = 0;
+
+            do
+            {
+                if (position >= aSize || shift >= 32)
+                    return false;
+
+                byte = pData[position++];
+                size |= static_cast<uint32_t>(byte & 0x7F) << shift;
+                shift += 7;
+            } while (byte & 0x80);
+
+            if (size == 0 || size > aSize - position || pData[position] == kServerMessageBundle)
+                return false;
+
+            acFunctor(pData + position, size);
+            position += size;
+        }
+
+        return true;
+    }
+};
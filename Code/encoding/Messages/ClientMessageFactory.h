@@ -56,10 +56,98 @@
 
 using TiltedPhoques::UniquePtr;
 
+// Messages whose DeserializeRaw overwrites every field, Decode reuses them without resetting them first
+template <class T>
+concept ReusableClientMessage = T::Reusable;
+
 struct ClientMessageFactory
 {
     UniquePtr<ClientMessage> Extract(TiltedPhoques::Buffer::Reader& aReader) const noexcept;
 
+    // Reads the opcode, deserializes the message into an instance reused by every message of that type on this
+    // thread and calls aFunctor with it. The message is only valid during the call. Reusable messages keep the
+    // capacity of their containers across calls, the others are reset first and allocate like a new message would.
+    // Dispatch is a chain of opcode compares the compiler can turn into a switch. Returns false on unknown opcodes.
+    template <class T>
+    static bool Decode(TiltedPhoques::Buffer::Reader& aReader, T&& aFunctor) noexcept
+    {
+        uint64_t data;
+        aReader.ReadBits(data, sizeof(ClientOpcode) * 8);
+
+        bool decoded = false;
+
+        Visit([&](auto& x) {
+            using TMessage = typename std::remove_reference_t<decltype(x)>::Type;
+
+            if (data != TMessage::Opcode)
+                return false;
+
+            static thread_local TMessage s_message;
+            if constexpr (!ReusableClientMessage<TMessage>)
+                s_message = TMessage{};
+
+            s_message.DeserializeRaw(aReader);
+            aFunctor(s_message);
+
+            decoded = true;
+            return true;
+        });
+
+        return decoded;
+    }
+
+    // Like Extract, but deserializes into apMessage when it already holds a message of the same type so that a
+    // long lived owner (a queue slot) stops allocating once it has seen the type. Reuse follows the same rules as
+    // Decode. apMessage is left untouched on unknown opcodes and false is returned.
+    static bool DecodeInto(TiltedPhoques::Buffer::Reader& aReader, UniquePtr<ClientMessage>& apMessage) noexcept
+    {
+        uint64_t data;
+        aReader.ReadBits(data, sizeof(ClientOpcode) * 8);
+
+        bool decoded = false;
+
+        Visit([&](auto& x) {
+            using TMessage = typename std::remove_reference_t<decltype(x)>::Type;
+
+            if (data != TMessage::Opcode)
+                return false;
+
+            if (!apMessage || apMessage->GetOpcode() != TMessage::Opcode)
+                apMessage = TiltedPhoques::CastUnique<ClientMessage>(TiltedPhoques::MakeUnique<TMessage>());
+            else if constexpr (!ReusableClientMessage<TMessage>)
+                static_cast<TMessage&>(*apMessage) = TMessage{};
+
+            static_cast<TMessage&>(*apMessage).DeserializeRaw(aReader);
+
+            decoded = true;
+            return true;
+        });
+
+        return decoded;
+    }
+
+    // Calls aFunctor with an extracted message as its concrete type, dispatched the same way as Decode
+    template <class T>
+    static bool Cast(ClientMessage& aMessage, T&& aFunctor) noexcept
+    {
+        const auto cOpcode = aMessage.GetOpcode();
+        bool cast = false;
+
+        Visit([&](auto& x) {
+            using TMessage = typename std::remove_reference_t<decltype(x)>::Type;
+
+            if (cOpcode != TMessage::Opcode)
+                return false;
+
+            aFunctor(static_cast<TMessage&>(aMessage));
+
+            cast = true;
+            return true;
+        });
+
+        return cast;
+    }
+
     template <class T>
     static auto Visit(T&& func)
     {
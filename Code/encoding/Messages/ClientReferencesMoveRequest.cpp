@@ -20,6 +20,7 @@ void ClientReferencesMoveRequest::DeserializeRaw(TiltedPhoques::Buffer::Reader&
     Tick = Serialization::ReadVarInt(aReader);
     const auto count = Serialization::ReadVarInt(aReader);
 
+    Updates.clear();
     for (auto i = 0u; i < count; ++i)
     {
         uint32_t serverId = Serialization::ReadVarInt(aReader) & 0xFFFFFFFF;
@@ -8,6 +8,8 @@ using TiltedPhoques::String;
 struct ClientReferencesMoveRequest final : ClientMessage
 {
     static constexpr ClientOpcode Opcode = kClientReferencesMoveRequest;
+    // Sent at a high rate, decoding into the same instance keeps the update map's buckets
+    static constexpr bool Reusable = true;
 
     ClientReferencesMoveRequest() : ClientMessage(Opcode)
     {
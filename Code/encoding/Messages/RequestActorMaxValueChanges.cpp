@@ -19,6 +19,7 @@ void RequestActorMaxValueChanges::DeserializeRaw(TiltedPhoques::Buffer::Reader&
     Id = Serialization::ReadVarInt(aReader) & 0xFFFFFFFF;
 
     auto count = Serialization::ReadVarInt(aReader);
+    Values.clear();
     for (decltype(count) i = 0; i < count; i++)
     {
         uint32_t key = Serialization::ReadVarInt(aReader) & 0xFFFFFFFF;
@@ -5,6 +5,8 @@
 struct RequestActorMaxValueChanges final : ClientMessage
 {
     static constexpr ClientOpcode Opcode = kRequestActorMaxValueChanges;
+    // Sent at a high rate, decoding into the same instance keeps the value map's buckets
+    static constexpr bool Reusable = true;
 
     RequestActorMaxValueChanges() : ClientMessage(Opcode)
     {
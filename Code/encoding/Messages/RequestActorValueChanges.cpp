@@ -19,6 +19,7 @@ void RequestActorValueChanges::DeserializeRaw(TiltedPhoques::Buffer::Reader& aRe
     Id = Serialization::ReadVarInt(aReader) & 0xFFFFFFFF;
 
     auto count = Serialization::ReadVarInt(aReader);
+    Values.clear();
     for (int i = 0; i < count; i++)
     {
         auto key = Serialization::ReadVarInt(aReader);
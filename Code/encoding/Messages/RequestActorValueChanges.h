@@ -5,6 +5,8 @@
 struct RequestActorValueChanges final : ClientMessage
 {
     static constexpr ClientOpcode Opcode = kRequestActorValueChanges;
+    // Sent at a high rate, decoding into the same instance keeps the value map's buckets
+    static constexpr bool Reusable = true;
 
     RequestActorValueChanges() : ClientMessage(Opcode)
     {
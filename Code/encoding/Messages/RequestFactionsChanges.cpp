@@ -22,6 +22,7 @@ void RequestFactionsChanges::DeserializeRaw(TiltedPhoques::Buffer::Reader& aRead
     uint64_t count = 0;
     aReader.ReadBits(count, 8);
 
+    Changes.clear();
     for (auto i = 0u; i < count; ++i)
     {
         auto& change = Changes[Serialization::ReadVarInt(aReader) & 0xFFFFFFFF];
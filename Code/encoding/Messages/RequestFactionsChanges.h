@@ -6,6 +6,8 @@
 struct RequestFactionsChanges final : ClientMessage
 {
     static constexpr ClientOpcode Opcode = kRequestFactionsChanges;
+    // Sent at a high rate, decoding into the same instance keeps the change map's buckets
+    static constexpr bool Reusable = true;
 
     RequestFactionsChanges() : ClientMessage(Opcode)
     {
@@ -5,6 +5,8 @@
 struct RequestHealthChangeBroadcast final : ClientMessage
 {
     static constexpr ClientOpcode Opcode = kRequestHealthChangeBroadcast;
+    // Every field is overwritten by DeserializeRaw
+    static constexpr bool Reusable = true;
 
     RequestHealthChangeBroadcast() : ClientMessage(Opcode)
     {
@@ -5,6 +5,8 @@
 struct RequestPlayerHealthUpdate final : ClientMessage
 {
     static constexpr ClientOpcode Opcode = kRequestPlayerHealthUpdate;
+    // Every field is overwritten by DeserializeRaw
+    static constexpr bool Reusable = true;
 
     RequestPlayerHealthUpdate() : ClientMessage(Opcode)
     {
@@ -37,5 +37,10 @@ UniquePtr<ServerMessage> ServerMessageFactory::Extract(TiltedPhoques::Buffer::Re
         return {nullptr};
 
     const auto opcode = static_cast<ServerOpcode>(data);
+
+    // Bundles are not messages, MessageBundle splits them before they get here
+    if (!s_serverMessageExtractor[opcode]) [[unlikely]]
+        return {nullptr};
+
     return s_serverMessageExtractor[opcode](aReader);
 }
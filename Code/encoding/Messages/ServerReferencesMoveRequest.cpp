@@ -7,10 +7,20 @@ void ServerReferencesMoveRequest::SerializeRaw(TiltedPhoques::Buffer::Writer& aW
     Serialization::WriteVarInt(aWriter, Updates.size());
 
     for (const auto& kvp : Updates)
-    {
-        Serialization::WriteVarInt(aWriter, kvp.first);
-        kvp.second.Serialize(aWriter);
-    }
+        SerializeUpdate(aWriter, kvp.first, kvp.second);
+}
+
+void ServerReferencesMoveRequest::SerializeHeader(TiltedPhoques::Buffer::Writer& aWriter, uint64_t aTick, size_t aCount) noexcept
+{
+    aWriter.WriteBits(Opcode, sizeof(ServerOpcode) * 8);
+    Serialization::WriteVarInt(aWriter, aTick);
+    Serialization::WriteVarInt(aWriter, aCount);
+}
+
+void ServerReferencesMoveRequest::SerializeUpdate(TiltedPhoques::Buffer::Writer& aWriter, uint32_t aServerId, const ReferenceUpdate& acUpdate) noexcept
+{
+    Serialization::WriteVarInt(aWriter, aServerId);
+    acUpdate.Serialize(aWriter);
 }
 
 void ServerReferencesMoveRequest::DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept
@@ -16,6 +16,11 @@ struct ServerReferencesMoveRequest final : ServerMessage
     void SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept override;
     void DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept override;
 
+    // For senders that write the updates one at a time without building the map. The header is everything before
+    // the updates, opcode included, and only holds whole bytes so it can be put in front of updates written first.
+    static void SerializeHeader(TiltedPhoques::Buffer::Writer& aWriter, uint64_t aTick, size_t aCount) noexcept;
+    static void SerializeUpdate(TiltedPhoques::Buffer::Writer& aWriter, uint32_t aServerId, const ReferenceUpdate& acUpdate) noexcept;
+
     bool operator==(const ServerReferencesMoveRequest& acRhs) const noexcept
     {
         return Updates == acRhs.Updates &&
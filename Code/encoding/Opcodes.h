@@ -108,5 +108,7 @@ enum ServerOpcode : unsigned char
     kNotifyPlayerHealthUpdate,
     kNotifySettingsChange,
     kNotifyWeatherChange,
+    // Container of other messages, see MessageBundle
+    kServerMessageBundle,
     kServerOpcodeMax
 };
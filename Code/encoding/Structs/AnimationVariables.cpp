@@ -29,6 +29,21 @@ void AnimationVariables::Save(std::ostream& aOutput) const
 }
 
 void AnimationVariables::GenerateDiff(const AnimationVariables& aPrevious, TiltedPhoques::Buffer::Writer& aWriter) const
+{
+    SerializeChanges(aWriter, GetChanges(aPrevious));
+}
+
+void AnimationVariables::ApplyDiff(TiltedPhoques::Buffer::Reader& aReader)
+{
+    AnimationVariables changes;
+    uint64_t changeMask = 0;
+
+    changes.DeserializeChanges(aReader, changeMask);
+
+    ApplyChanges(changes, changeMask);
+}
+
+uint64_t AnimationVariables::GetChanges(const AnimationVariables& aPrevious) const noexcept
 {
     uint64_t changes = 0;
     uint32_t idx = 0;
@@ -39,41 +54,41 @@ void AnimationVariables::GenerateDiff(const AnimationVariables& aPrevious, Tilte
     }
     ++idx;
 
-    auto integers = aPrevious.Integers;
-    if (integers.empty())
-        integers.assign(Integers.size(), 0);
-
+    // A previous state of a different size (usually empty) is compared as if it was zeroed
+    const bool cSameIntegers = aPrevious.Integers.size() == Integers.size();
     for (auto i = 0u; i < Integers.size(); ++i)
     {
-        if (Integers[i] != integers[i])
+        if (Integers[i] != (cSameIntegers ? aPrevious.Integers[i] : 0))
         {
             changes |= (1ull << idx);
         }
         ++idx;
     }
 
-    auto floats = aPrevious.Floats;
-    if (floats.empty())
-        floats.assign(Floats.size(), 0.f);
-
+    const bool cSameFloats = aPrevious.Floats.size() == Floats.size();
     for (auto i = 0u; i < Floats.size(); ++i)
     {
-        if (Floats[i] != floats[i])
+        if (Floats[i] != (cSameFloats ? aPrevious.Floats[i] : 0.f))
         {
             changes |= (1ull << idx);
         }
         ++idx;
     }
 
+    return changes;
+}
+
+void AnimationVariables::SerializeChanges(TiltedPhoques::Buffer::Writer& aWriter, uint64_t aChanges) const
+{
     TiltedPhoques::Serialization::WriteVarInt(aWriter, Integers.size());
     TiltedPhoques::Serialization::WriteVarInt(aWriter, Floats.size());
 
     const auto cDiffBitCount = 1 + Integers.size() + Floats.size();
 
-    aWriter.WriteBits(changes, cDiffBitCount);
+    aWriter.WriteBits(aChanges, cDiffBitCount);
 
-    idx = 0;
-    if (changes & (1ull << idx))
+    uint32_t idx = 0;
+    if (aChanges & (1ull << idx))
     {
         aWriter.WriteBits(Booleans, 64);
     }
@@ -81,7 +96,7 @@ void AnimationVariables::GenerateDiff(const AnimationVariables& aPrevious, Tilte
 
     for (const auto value : Integers)
     {
-        if (changes & (1ull << idx))
+        if (aChanges & (1ull << idx))
         {
             TiltedPhoques::Serialization::WriteVarInt(aWriter, value & 0xFFFFFFFF);
         }
@@ -90,7 +105,7 @@ void AnimationVariables::GenerateDiff(const AnimationVariables& aPrevious, Tilte
 
     for (const auto value : Floats)
     {
-        if (changes & (1ull << idx))
+        if (aChanges & (1ull << idx))
         {
             aWriter.WriteBits(*reinterpret_cast<const uint32_t*>(&value), 32);
         }
@@ -98,34 +113,28 @@ void AnimationVariables::GenerateDiff(const AnimationVariables& aPrevious, Tilte
     }
 }
 
-void AnimationVariables::ApplyDiff(TiltedPhoques::Buffer::Reader& aReader)
+void AnimationVariables::DeserializeChanges(TiltedPhoques::Buffer::Reader& aReader, uint64_t& aChanges)
 {
     const auto cIntegersSize = TiltedPhoques::Serialization::ReadVarInt(aReader);
     if (cIntegersSize > 0xFF)
         throw std::runtime_error("Too many integers received !");
 
-    if (Integers.size() != cIntegersSize)
-    {
-        Integers.assign(cIntegersSize, 0);
-    }
-
     const auto cFloatsSize = TiltedPhoques::Serialization::ReadVarInt(aReader);
     if (cFloatsSize > 0xFF)
         throw std::runtime_error("Too many floats received !");
 
-    if (Floats.size() != cFloatsSize)
-    {
-        Floats.assign(cFloatsSize, 0.f);
-    }
+    Booleans = 0;
+    Integers.assign(cIntegersSize, 0);
+    Floats.assign(cFloatsSize, 0.f);
 
     const auto cDiffBitCount = 1 + Integers.size() + Floats.size();
 
-    uint64_t changes = 0;
+    aChanges = 0;
     uint32_t idx = 0;
 
-    aReader.ReadBits(changes, cDiffBitCount);
+    aReader.ReadBits(aChanges, cDiffBitCount);
 
-    if (changes & (1ull << idx))
+    if (aChanges & (1ull << idx))
     {
         aReader.ReadBits(Booleans, 64);
     }
@@ -133,17 +142,16 @@ void AnimationVariables::ApplyDiff(TiltedPhoques::Buffer::Reader& aReader)
 
     for (auto& value : Integers)
     {
-        if (changes & (1ull << idx))
+        if (aChanges & (1ull << idx))
         {
             value = TiltedPhoques::Serialization::ReadVarInt(aReader) & 0xFFFFFFFF;
         }
         ++idx;
     }
 
-
     for (auto& value : Floats)
     {
-        if (changes & (1ull << idx))
+        if (aChanges & (1ull << idx))
         {
             uint64_t tmp = 0;
             aReader.ReadBits(tmp, 32);
@@ -153,3 +161,41 @@ void AnimationVariables::ApplyDiff(TiltedPhoques::Buffer::Reader& aReader)
         ++idx;
     }
 }
+
+void AnimationVariables::ApplyChanges(const AnimationVariables& acChanges, uint64_t aChanges) noexcept
+{
+    if (Integers.size() != acChanges.Integers.size())
+    {
+        Integers.assign(acChanges.Integers.size(), 0);
+    }
+
+    if (Floats.size() != acChanges.Floats.size())
+    {
+        Floats.assign(acChanges.Floats.size(), 0.f);
+    }
+
+    uint32_t idx = 0;
+    if (aChanges & (1ull << idx))
+    {
+        Booleans = acChanges.Booleans;
+    }
+    ++idx;
+
+    for (auto i = 0u; i < Integers.size(); ++i)
+    {
+        if (aChanges & (1ull << idx))
+        {
+            Integers[i] = acChanges.Integers[i];
+        }
+        ++idx;
+    }
+
+    for (auto i = 0u; i < Floats.size(); ++i)
+    {
+        if (aChanges & (1ull << idx))
+        {
+            Floats[i] = acChanges.Floats[i];
+        }
+        ++idx;
+    }
+}
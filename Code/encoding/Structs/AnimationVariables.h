@@ -18,4 +18,13 @@ struct AnimationVariables
 
     void GenerateDiff(const AnimationVariables& aPrevious, TiltedPhoques::Buffer::Writer& aWriter) const;
     void ApplyDiff(TiltedPhoques::Buffer::Reader& aReader);
+
+    // Change mask against a previous state, bit 0 is Booleans, then one bit per integer followed by one bit per float
+    [[nodiscard]] uint64_t GetChanges(const AnimationVariables& aPrevious) const noexcept;
+    // Writes the sizes, the change mask and the values selected by the mask
+    void SerializeChanges(TiltedPhoques::Buffer::Writer& aWriter, uint64_t aChanges) const;
+    // Reads what SerializeChanges wrote, values that are not in the mask are left zeroed
+    void DeserializeChanges(TiltedPhoques::Buffer::Reader& aReader, uint64_t& aChanges);
+    // Copies the values selected by the mask, vectors are reset if their size differs
+    void ApplyChanges(const AnimationVariables& acChanges, uint64_t aChanges) noexcept;
 };
@@ -14,7 +14,22 @@ struct GridCellCoords
     static GridCellCoords CalculateGridCellCoords(const Vector3_NetQuantize& aCoords) noexcept;
     static GridCellCoords CalculateGridCellCoords(const float aX, const float aY) noexcept;
     static bool AreGridCellsOverlapping(const GridCellCoords& aCoords1, const GridCellCoords& aCoords2) noexcept;
-    static bool IsCellInGridCell(const GridCellCoords& aCell, const GridCellCoords& aGridCell, bool aIsDragon) noexcept;
+
+    // Inline as it runs for every entity and player pair on each replication tick
+    static bool IsCellInGridCell(const GridCellCoords& aCell, const GridCellCoords& aGridCell, bool aIsDragon) noexcept
+    {
+        const int32_t distanceToBorder = GetGridRadius(aIsDragon);
+        const int32_t deltaX = aCell.X - aGridCell.X;
+        const int32_t deltaY = aCell.Y - aGridCell.Y;
+
+        return deltaX >= -distanceToBorder && deltaX <= distanceToBorder && deltaY >= -distanceToBorder && deltaY <= distanceToBorder;
+    }
+
+    // Number of cells loaded on each side of the center cell
+    static constexpr int32_t GetGridRadius(bool aIsDragon) noexcept
+    {
+        return (aIsDragon ? m_gridsToLoadIfDragon : m_gridsToLoad) / 2;
+    }
 
     GridCellCoords();
     GridCellCoords(int32_t aX, int32_t aY) noexcept;
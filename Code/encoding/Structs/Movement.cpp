@@ -42,3 +42,101 @@ void Movement::Deserialize(TiltedPhoques::Buffer::Reader& aReader) noexcept
     uint32_t tmp32 = tmp & 0xFFFFFFFF;
     Direction = *reinterpret_cast<float*>(&tmp32);
 }
+
+uint8_t Movement::GetChanges(const Movement& aPrevious) const noexcept
+{
+    uint8_t changes = 0;
+
+    if (CellId != aPrevious.CellId || WorldSpaceId != aPrevious.WorldSpaceId)
+        changes |= kCellChanged;
+
+    if (Position != aPrevious.Position)
+        changes |= kPositionChanged;
+
+    if (Rotation != aPrevious.Rotation)
+        changes |= kRotationChanged;
+
+    if (Variables != aPrevious.Variables)
+        changes |= kVariablesChanged;
+
+    if (Direction != aPrevious.Direction)
+        changes |= kDirectionChanged;
+
+    return changes;
+}
+
+void Movement::SerializeChanges(TiltedPhoques::Buffer::Writer& aWriter, uint8_t aChanges, uint64_t aVariableChanges) const noexcept
+{
+    aWriter.WriteBits(aChanges, 5);
+
+    if (aChanges & kCellChanged)
+    {
+        CellId.Serialize(aWriter);
+        WorldSpaceId.Serialize(aWriter);
+    }
+
+    if (aChanges & kPositionChanged)
+        Position.Serialize(aWriter);
+
+    if (aChanges & kRotationChanged)
+        Rotation.Serialize(aWriter);
+
+    if (aChanges & kVariablesChanged)
+        Variables.SerializeChanges(aWriter, aVariableChanges);
+
+    if (aChanges & kDirectionChanged)
+        aWriter.WriteBits(*reinterpret_cast<const uint32_t*>(&Direction), 32);
+}
+
+void Movement::DeserializeChanges(TiltedPhoques::Buffer::Reader& aReader, uint8_t& aChanges, uint64_t& aVariableChanges) noexcept
+{
+    uint64_t changes = 0;
+    aReader.ReadBits(changes, 5);
+
+    aChanges = changes & kAllChanged;
+    aVariableChanges = 0;
+
+    if (aChanges & kCellChanged)
+    {
+        CellId.Deserialize(aReader);
+        WorldSpaceId.Deserialize(aReader);
+    }
+
+    if (aChanges & kPositionChanged)
+        Position.Deserialize(aReader);
+
+    if (aChanges & kRotationChanged)
+        Rotation.Deserialize(aReader);
+
+    if (aChanges & kVariablesChanged)
+        Variables.DeserializeChanges(aReader, aVariableChanges);
+
+    if (aChanges & kDirectionChanged)
+    {
+        uint64_t tmp = 0;
+        aReader.ReadBits(tmp, 32);
+        uint32_t tmp32 = tmp & 0xFFFFFFFF;
+        Direction = *reinterpret_cast<float*>(&tmp32);
+    }
+}
+
+void Movement::ApplyChanges(const Movement& acChanges, uint8_t aChanges, uint64_t aVariableChanges) noexcept
+{
+    if (aChanges & kCellChanged)
+    {
+        CellId = acChanges.CellId;
+        WorldSpaceId = acChanges.WorldSpaceId;
+    }
+
+    if (aChanges & kPositionChanged)
+        Position = acChanges.Position;
+
+    if (aChanges & kRotationChanged)
+        Rotation = acChanges.Rotation;
+
+    if (aChanges & kVariablesChanged)
+        Variables.ApplyChanges(acChanges.Variables, aVariableChanges);
+
+    if (aChanges & kDirectionChanged)
+        Direction = acChanges.Direction;
+}
@@ -10,6 +10,16 @@ using TiltedPhoques::Buffer;
 
 struct Movement
 {
+    enum ChangeFlags : uint8_t
+    {
+        kCellChanged        = 1 << 0,
+        kPositionChanged    = 1 << 1,
+        kRotationChanged    = 1 << 2,
+        kVariablesChanged   = 1 << 3,
+        kDirectionChanged   = 1 << 4,
+        kAllChanged         = 0x1F
+    };
+
     Movement() = default;
     ~Movement() = default;
 
@@ -19,6 +29,12 @@ struct Movement
     void Serialize(TiltedPhoques::Buffer::Writer& aWriter) const noexcept;
     void Deserialize(TiltedPhoques::Buffer::Reader& aReader) noexcept;
 
+    [[nodiscard]] uint8_t GetChanges(const Movement& aPrevious) const noexcept;
+    // Writes the fields selected by aChanges, variables are restricted to the ones selected by aVariableChanges
+    void SerializeChanges(TiltedPhoques::Buffer::Writer& aWriter, uint8_t aChanges, uint64_t aVariableChanges) const noexcept;
+    void DeserializeChanges(TiltedPhoques::Buffer::Reader& aReader, uint8_t& aChanges, uint64_t& aVariableChanges) noexcept;
+    void ApplyChanges(const Movement& acChanges, uint8_t aChanges, uint64_t aVariableChanges) noexcept;
+
     GameId CellId{};
     GameId WorldSpaceId{};
     Vector3_NetQuantize Position{};
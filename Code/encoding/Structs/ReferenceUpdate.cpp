@@ -7,7 +7,8 @@ using TiltedPhoques::Serialization;
 bool ReferenceUpdate::operator==(const ReferenceUpdate& acRhs) const noexcept
 {
     return UpdatedMovement == acRhs.UpdatedMovement &&
-        ActionEvents == acRhs.ActionEvents;
+        ActionEvents == acRhs.ActionEvents &&
+        IsDelta == acRhs.IsDelta;
 }
 
 bool ReferenceUpdate::operator!=(const ReferenceUpdate& acRhs) const noexcept
@@ -17,7 +18,12 @@ bool ReferenceUpdate::operator!=(const ReferenceUpdate& acRhs) const noexcept
 
 void ReferenceUpdate::Serialize(TiltedPhoques::Buffer::Writer& aWriter) const noexcept
 {
-    UpdatedMovement.Serialize(aWriter);
+    aWriter.WriteBits(IsDelta ? 1 : 0, 1);
+
+    if (IsDelta)
+        UpdatedMovement.SerializeChanges(aWriter, MovementChanges, VariableChanges);
+    else
+        UpdatedMovement.Serialize(aWriter);
     
     Serialization::WriteVarInt(aWriter, ActionEvents.size());
 
@@ -29,7 +35,21 @@ void ReferenceUpdate::Serialize(TiltedPhoques::Buffer::Writer& aWriter) const no
 
 void ReferenceUpdate::Deserialize(TiltedPhoques::Buffer::Reader& aReader)
 {
-    UpdatedMovement.Deserialize(aReader);
+    uint64_t isDelta = 0;
+    aReader.ReadBits(isDelta, 1);
+    IsDelta = isDelta != 0;
+
+    if (IsDelta)
+    {
+        UpdatedMovement = Movement{};
+        UpdatedMovement.DeserializeChanges(aReader, MovementChanges, VariableChanges);
+    }
+    else
+    {
+        UpdatedMovement.Deserialize(aReader);
+        MovementChanges = Movement::kAllChanged;
+        VariableChanges = 0;
+    }
 
     const auto count = Serialization::ReadVarInt(aReader);
     // TODO: keeps throwing in fallout together with more than 2 players
@@ -43,3 +63,18 @@ void ReferenceUpdate::Deserialize(TiltedPhoques::Buffer::Reader& aReader)
         ActionEvents[i].ApplyDifferential(aReader);
     }
 }
+
+void ReferenceUpdate::MakeDelta(const Movement& acBaseline) noexcept
+{
+    IsDelta = true;
+    MovementChanges = UpdatedMovement.GetChanges(acBaseline);
+    VariableChanges = UpdatedMovement.Variables.GetChanges(acBaseline.Variables);
+}
+
+void ReferenceUpdate::ApplyTo(Movement& aBaseline) const noexcept
+{
+    if (IsDelta)
+        aBaseline.ApplyChanges(UpdatedMovement, MovementChanges, VariableChanges);
+    else
+        aBaseline = UpdatedMovement;
+}
@@ -18,6 +18,15 @@ struct ReferenceUpdate
     void Serialize(TiltedPhoques::Buffer::Writer& aWriter) const noexcept;
     void Deserialize(TiltedPhoques::Buffer::Reader& aReader);
 
+    // Turns this update into a delta of UpdatedMovement against the last movement sent for the reference
+    void MakeDelta(const Movement& acBaseline) noexcept;
+    // Rebuilds the full movement on top of the last movement received for the reference
+    void ApplyTo(Movement& aBaseline) const noexcept;
+
     Movement UpdatedMovement{};
     Vector<ActionEvent> ActionEvents{};
+    // When set, only the fields of UpdatedMovement selected by the masks below are meaningful
+    bool IsDelta{false};
+    uint8_t MovementChanges{Movement::kAllChanged};
+    uint64_t VariableChanges{0};
 };
@@ -0,0 +1,127 @@
+#include "PluginWriter.h"
+
+#include <zlib.h>
+
+#include <cstring>
+
+namespace
+{
+constexpr size_t kHeaderSize = 24;
+// Form version written by the Skyrim SE creation kit
+constexpr uint16_t kFormVersion = 44;
+
+uint32_t FourCC(std::string_view aType) noexcept
+{
+    uint32_t value = 0;
+    std::memcpy(&value, aType.data(), std::min<size_t>(aType.size(), sizeof(value)));
+    return value;
+}
+} // namespace
+
+PluginWriter::PluginWriter(const std::filesystem::path& acPath) noexcept
+    : m_file(acPath, std::ios::binary | std::ios::trunc)
+{
+}
+
+void PluginWriter::BeginGroup(uint32_t aLabel, GroupType aType) noexcept
+{
+    m_groupStack.push_back(GetSize());
+    WriteHeader("GRUP", 0, aLabel, static_cast<uint32_t>(aType), 0);
+}
+
+void PluginWriter::BeginGroup(std::string_view aLabel) noexcept
+{
+    BeginGroup(FourCC(aLabel), kTopLevel);
+}
+
+void PluginWriter::EndGroup() noexcept
+{
+    const uint64_t start = m_groupStack.back();
+    m_groupStack.pop_back();
+
+    // Group sizes include their own header
+    const uint64_t end = GetSize();
+    const uint32_t size = static_cast<uint32_t>(end - start);
+
+    m_file.seekp(static_cast<std::streamoff>(start + 4));
+    WriteRaw(&size, sizeof(size));
+    m_file.seekp(static_cast<std::streamoff>(end));
+}
+
+void PluginWriter::BeginRecord(std::string_view aType, uint32_t aFormId, uint32_t aFlags) noexcept
+{
+    m_recordType = aType;
+    m_recordFormId = aFormId;
+    m_recordFlags = aFlags;
+    m_recordData.clear();
+}
+
+void PluginWriter::EndRecord(bool aCompress) noexcept
+{
+    ++m_recordCount;
+
+    if (!aCompress)
+    {
+        WriteHeader(m_recordType, static_cast<uint32_t>(m_recordData.size()), m_recordFlags, m_recordFormId, kFormVersion);
+        WriteRaw(m_recordData.data(), m_recordData.size());
+        return;
+    }
+
+    uLongf compressedSize = compressBound(static_cast<uLong>(m_recordData.size()));
+    m_compressed.resize(compressedSize);
+    compress2(m_compressed.data(), &compressedSize, m_recordData.data(), static_cast<uLong>(m_recordData.size()), Z_DEFAULT_COMPRESSION);
+
+    const uint32_t inflatedSize = static_cast<uint32_t>(m_recordData.size());
+    const uint32_t dataSize = static_cast<uint32_t>(sizeof(inflatedSize) + compressedSize);
+
+    WriteHeader(m_recordType, dataSize, m_recordFlags | kCompressedFlag, m_recordFormId, kFormVersion);
+    WriteRaw(&inflatedSize, sizeof(inflatedSize));
+    WriteRaw(m_compressed.data(), compressedSize);
+}
+
+void PluginWriter::WriteChunk(std::string_view aType, const void* apData, size_t aSize) noexcept
+{
+    const uint32_t type = FourCC(aType);
+    const uint16_t size = static_cast<uint16_t>(aSize);
+
+    const auto* pType = reinterpret_cast<const uint8_t*>(&type);
+    const auto* pSize = reinterpret_cast<const uint8_t*>(&size);
+    const auto* pData = static_cast<const uint8_t*>(apData);
+
+    m_recordData.insert(m_recordData.end(), pType, pType + sizeof(type));
+    m_recordData.insert(m_recordData.end(), pSize, pSize + sizeof(size));
+    m_recordData.insert(m_recordData.end(), pData, pData + aSize);
+}
+
+void PluginWriter::WriteZString(std::string_view aType, std::string_view aValue) noexcept
+{
+    Vector<char> value(aValue.begin(), aValue.end());
+    value.push_back('\0');
+
+    WriteChunk(aType, value.data(), value.size());
+}
+
+bool PluginWriter::Close() noexcept
+{
+    m_file.close();
+    return !m_file.fail();
+}
+
+void PluginWriter::WriteHeader(std::string_view aType, uint32_t aSize, uint32_t aFirst, uint32_t aSecond, uint16_t aFormVersion) noexcept
+{
+    uint8_t header[kHeaderSize]{};
+
+    const uint32_t type = FourCC(aType);
+    std::memcpy(header, &type, 4);
+    std::memcpy(header + 4, &aSize, 4);
+    std::memcpy(header + 8, &aFirst, 4);
+    std::memcpy(header + 12, &aSecond, 4);
+    std::memcpy(header + 20, &aFormVersion, 2);
+
+    WriteRaw(header, sizeof(header));
+}
+
+void PluginWriter::WriteRaw(const void* apData, size_t aSize) noexcept
+{
+    m_file.write(static_cast<const char*>(apData), static_cast<std::streamsize>(aSize));
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <TiltedCore/Stl.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+
+using TiltedPhoques::Vector;
+
+/**
+* @brief Streams a plugin file in the TES4 format.
+*
+* Groups are opened and closed like scopes, their sizes are patched once closed. Chunks are buffered per
+* record so records can be compressed as a whole.
+*/
+class PluginWriter
+{
+  public:
+    // Group types as stored in the GRUP header
+    enum GroupType : int32_t
+    {
+        kTopLevel = 0,
+        kWorldChildren = 1,
+        kInteriorCellBlock = 2,
+        kInteriorCellSubBlock = 3,
+        kCellChildren = 6,
+        kCellTemporaryChildren = 9,
+    };
+
+    static constexpr uint32_t kCompressedFlag = 0x40000;
+
+    explicit PluginWriter(const std::filesystem::path& acPath) noexcept;
+
+    [[nodiscard]] bool IsOpen() const noexcept
+    {
+        return m_file.good();
+    }
+    [[nodiscard]] uint64_t GetSize() noexcept
+    {
+        return static_cast<uint64_t>(m_file.tellp());
+    }
+    [[nodiscard]] uint32_t GetRecordCount() const noexcept
+    {
+        return m_recordCount;
+    }
+
+    void BeginGroup(uint32_t aLabel, GroupType aType) noexcept;
+    void BeginGroup(std::string_view aLabel) noexcept;
+    void EndGroup() noexcept;
+
+    void BeginRecord(std::string_view aType, uint32_t aFormId, uint32_t aFlags = 0) noexcept;
+    // Compressed records store the inflated size followed by the zlib stream of their chunks
+    void EndRecord(bool aCompress = false) noexcept;
+
+    void WriteChunk(std::string_view aType, const void* apData, size_t aSize) noexcept;
+    void WriteZString(std::string_view aType, std::string_view aValue) noexcept;
+    template <class T> void WriteChunk(std::string_view aType, const T& acValue) noexcept
+    {
+        WriteChunk(aType, &acValue, sizeof(T));
+    }
+
+    bool Close() noexcept;
+
+  private:
+    // Records and groups share the 24 byte header layout, only the meaning of the middle fields differs
+    void WriteHeader(std::string_view aType, uint32_t aSize, uint32_t aFirst, uint32_t aSecond, uint16_t aFormVersion) noexcept;
+    void WriteRaw(const void* apData, size_t aSize) noexcept;
+
+    std::ofstream m_file;
+    Vector<uint64_t> m_groupStack{};
+    Vector<uint8_t> m_recordData{};
+    Vector<uint8_t> m_compressed{};
+    std::string m_recordType{};
+    uint32_t m_recordFormId = 0;
+    uint32_t m_recordFlags = 0;
+    uint32_t m_recordCount = 0;
+};
@@ -0,0 +1,457 @@
+#include "SyntheticPlugin.h"
+#include "PluginWriter.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace
+{
+constexpr uint32_t kFirstObjectId = 0x800;
+constexpr uint32_t kReferencesPerCell = 128;
+constexpr uint32_t kMasterFlag = 0x1;
+constexpr uint32_t kLightFlag = 0x200;
+// Keeps a NVNM chunk below the 64 KiB chunk size limit
+constexpr uint32_t kMaxNavMeshVertices = 1024;
+
+struct Vec3
+{
+    float X, Y, Z;
+};
+
+struct Triangle
+{
+    int16_t Vertices[3];
+    int16_t Edges[3];
+    int16_t CoverMarker;
+    int16_t CoverFlags;
+};
+
+static_assert(sizeof(Vec3) == 12);
+static_assert(sizeof(Triangle) == 16);
+
+struct Generator
+{
+    Generator(PluginWriter& aWriter, const SyntheticPluginSettings& acSettings) noexcept
+        : m_writer(aWriter)
+        , m_settings(acSettings)
+        , m_random(acSettings.Seed)
+        , m_ownPrefix(static_cast<uint32_t>(acSettings.Masters.size()) << 24)
+        , m_nextObjectId(kFirstObjectId)
+    {
+    }
+
+    void Write() noexcept
+    {
+        // References take the first ids so plugins can override the master's references by id
+        m_firstReferenceId = AllocateIds(m_settings.References);
+        m_firstNpcId = AllocateIds(m_settings.Npcs);
+        m_firstContainerId = AllocateIds(m_settings.Containers);
+        m_firstWorldId = AllocateIds(m_settings.Worlds);
+        m_firstNavMeshId = AllocateIds(m_settings.NavMeshes);
+
+        m_interiorCellCount = (m_settings.References + kReferencesPerCell - 1) / kReferencesPerCell;
+        if (m_settings.Worlds == 0 && m_settings.NavMeshes > 0)
+            m_interiorCellCount = std::max(m_interiorCellCount, 1u);
+
+        m_firstInteriorCellId = AllocateIds(m_interiorCellCount);
+        m_firstExteriorCellId = AllocateIds(m_settings.Worlds);
+
+        WriteHeader();
+        WriteNpcs();
+        WriteContainers();
+        WriteInteriorCells();
+        WriteWorlds();
+    }
+
+private:
+    uint32_t AllocateIds(uint32_t aCount) noexcept
+    {
+        const uint32_t first = m_nextObjectId;
+        m_nextObjectId += aCount;
+        return first;
+    }
+
+    uint32_t GetTotalRecordCount() const noexcept
+    {
+        return m_nextObjectId - kFirstObjectId;
+    }
+
+    void EndRecord() noexcept
+    {
+        const bool compress = m_settings.CompressEvery && (m_writer.GetRecordCount() % m_settings.CompressEvery) == 0;
+        m_writer.EndRecord(compress);
+    }
+
+    void WriteHeader() noexcept
+    {
+        uint32_t flags = 0;
+        if (m_settings.Master)
+            flags |= kMasterFlag;
+        if (m_settings.Lite)
+            flags |= kLightFlag;
+
+        m_writer.BeginRecord("TES4", 0, flags);
+
+#pragma pack(push, 1)
+        struct
+        {
+            float Version;
+            int32_t RecordCount;
+            uint32_t NextObjectId;
+        } header{1.71f, static_cast<int32_t>(GetTotalRecordCount()), m_nextObjectId};
+#pragma pack(pop)
+
+        m_writer.WriteChunk("HEDR", header);
+        m_writer.WriteZString("CNAM", "ESLoaderBenchmark");
+
+        for (const String& master : m_settings.Masters)
+        {
+            m_writer.WriteZString("MAST", master);
+            m_writer.WriteChunk("DATA", uint64_t{0});
+        }
+
+        // The file header is never compressed
+        m_writer.EndRecord(false);
+    }
+
+    void WriteNpcs() noexcept
+    {
+        if (m_settings.Npcs == 0)
+            return;
+
+        m_writer.BeginGroup("NPC_");
+
+        for (uint32_t i = 0; i < m_settings.Npcs; ++i)
+        {
+            m_writer.BeginRecord("NPC_", m_ownPrefix | (m_firstNpcId + i));
+            m_writer.WriteZString("EDID", fmt::format("SynthNpc{:06}", i));
+
+#pragma pack(push, 1)
+            struct
+            {
+                uint32_t Flags;
+                uint16_t Values[10];
+            } baseStats{};
+#pragma pack(pop)
+            static_assert(sizeof(baseStats) == 24);
+            baseStats.Flags = (i % 7 == 0) ? 1 << 5 : 0;
+            baseStats.Values[2] = static_cast<uint16_t>(1 + i % 50);
+            m_writer.WriteChunk("ACBS", baseStats);
+
+            const uint32_t outfitId = m_settings.Containers ? m_ownPrefix | m_firstContainerId : 0;
+            m_writer.WriteChunk("DOFT", outfitId);
+
+            WriteScript(fmt::format("SynthNpcScript{}", i % 16));
+
+            EndRecord();
+        }
+
+        m_writer.EndGroup();
+    }
+
+    // One script with one int property, enough to walk every branch of the VMAD header parsing
+    void WriteScript(const std::string& acName) noexcept
+    {
+        Vector<uint8_t> data;
+        auto append = [&data](const void* apData, size_t aSize) {
+            const auto* pData = static_cast<const uint8_t*>(apData);
+            data.insert(data.end(), pData, pData + aSize);
+        };
+        auto appendWString = [&](std::string_view aValue) {
+            const uint16_t length = static_cast<uint16_t>(aValue.size());
+            append(&length, sizeof(length));
+            append(aValue.data(), aValue.size());
+        };
+
+        const int16_t version = 5;
+        const int16_t objectFormat = 2;
+        const uint16_t scriptCount = 1;
+        append(&version, sizeof(version));
+        append(&objectFormat, sizeof(objectFormat));
+        append(&scriptCount, sizeof(scriptCount));
+
+        appendWString(acName);
+        const uint8_t status = 0;
+        const uint16_t propertyCount = 1;
+        append(&status, sizeof(status));
+        append(&propertyCount, sizeof(propertyCount));
+
+        appendWString("Value");
+        const uint8_t propertyType = 3; // INT
+        const uint8_t propertyStatus = 1;
+        const int32_t value = static_cast<int32_t>(m_random());
+        append(&propertyType, sizeof(propertyType));
+        append(&propertyStatus, sizeof(propertyStatus));
+        append(&value, sizeof(value));
+
+        m_writer.WriteChunk("VMAD", data.data(), data.size());
+    }
+
+    void WriteContainers() noexcept
+    {
+        if (m_settings.Containers == 0)
+            return;
+
+        m_writer.BeginGroup("CONT");
+
+        for (uint32_t i = 0; i < m_settings.Containers; ++i)
+        {
+            m_writer.BeginRecord("CONT", m_ownPrefix | (m_firstContainerId + i));
+            m_writer.WriteZString("EDID", fmt::format("SynthContainer{:06}", i));
+
+            for (uint32_t j = 0; j < 1 + i % 8; ++j)
+            {
+                const uint32_t item[2] = {m_ownPrefix | (m_firstContainerId + (i + j) % m_settings.Containers), 1 + j};
+                m_writer.WriteChunk("CNTO", item);
+            }
+
+            EndRecord();
+        }
+
+        m_writer.EndGroup();
+    }
+
+    void WriteInteriorCells() noexcept
+    {
+        if (m_interiorCellCount == 0)
+            return;
+
+        const uint32_t overrideCount = m_settings.Masters.empty() ? 0 : m_settings.References * m_settings.OverridePercent / 100;
+        const uint32_t interiorNavMeshes = m_settings.Worlds ? 0 : m_settings.NavMeshes;
+
+        m_writer.BeginGroup("CELL");
+        m_writer.BeginGroup(0, PluginWriter::kInteriorCellBlock);
+        m_writer.BeginGroup(0, PluginWriter::kInteriorCellSubBlock);
+
+        for (uint32_t cell = 0; cell < m_interiorCellCount; ++cell)
+        {
+            const uint32_t cellId = m_ownPrefix | (m_firstInteriorCellId + cell);
+
+            m_writer.BeginRecord("CELL", cellId);
+            m_writer.WriteZString("EDID", fmt::format("SynthCell{:05}", cell));
+            m_writer.WriteChunk("DATA", uint16_t{1}); // Interior
+            EndRecord();
+
+            m_writer.BeginGroup(cellId, PluginWriter::kCellChildren);
+            m_writer.BeginGroup(cellId, PluginWriter::kCellTemporaryChildren);
+
+            const uint32_t firstReference = cell * kReferencesPerCell;
+            const uint32_t lastReference = std::min(firstReference + kReferencesPerCell, m_settings.References);
+            for (uint32_t i = firstReference; i < lastReference; ++i)
+            {
+                // Overrides reuse the master's id, which shares the same id layout
+                const uint32_t prefix = i < overrideCount ? 0 : m_ownPrefix;
+                WriteReference(prefix | (m_firstReferenceId + i), i);
+            }
+
+            for (uint32_t i = cell; i < interiorNavMeshes; i += m_interiorCellCount)
+                WriteNavMesh(m_ownPrefix | (m_firstNavMeshId + i), 0, cellId, 0, 0);
+
+            m_writer.EndGroup();
+            m_writer.EndGroup();
+        }
+
+        m_writer.EndGroup();
+        m_writer.EndGroup();
+        m_writer.EndGroup();
+    }
+
+    void WriteReference(uint32_t aFormId, uint32_t aIndex) noexcept
+    {
+        std::uniform_real_distribution<float> position(-50000.f, 50000.f);
+
+        m_writer.BeginRecord("REFR", aFormId);
+
+        const uint32_t baseId = m_settings.Containers ? m_ownPrefix | (m_firstContainerId + aIndex % m_settings.Containers) : m_ownPrefix | aFormId;
+        m_writer.WriteChunk("NAME", baseId);
+
+        if (aIndex % 16 == 0)
+        {
+            m_writer.WriteChunk("XMRK", nullptr, 0);
+            m_writer.WriteChunk("FNAM", uint8_t{1});
+            m_writer.WriteChunk("TNAM", uint16_t{static_cast<uint16_t>(aIndex % 60)});
+        }
+
+        const float data[6] = {position(m_random), position(m_random), position(m_random) * 0.1f, 0.f, 0.f, 0.f};
+        m_writer.WriteChunk("DATA", data);
+
+        EndRecord();
+    }
+
+    void WriteWorlds() noexcept
+    {
+        if (m_settings.Worlds == 0)
+            return;
+
+        m_writer.BeginGroup("WRLD");
+
+        for (uint32_t world = 0; world < m_settings.Worlds; ++world)
+        {
+            const uint32_t worldId = m_ownPrefix | (m_firstWorldId + world);
+
+            m_writer.BeginRecord("WRLD", worldId);
+            m_writer.WriteZString("EDID", fmt::format("SynthWorld{:03}", world));
+            const int16_t center[2] = {0, 0};
+            m_writer.WriteChunk("WCTR", center);
+            const float landData[2] = {-2048.f, 0.f};
+            m_writer.WriteChunk("DNAM", landData);
+            m_writer.WriteChunk("NAMA", 1.f);
+            EndRecord();
+
+            m_writer.BeginGroup(worldId, PluginWriter::kWorldChildren);
+
+            // Persistent cell holding the world's nav meshes
+            const uint32_t cellId = m_ownPrefix | (m_firstExteriorCellId + world);
+            m_writer.BeginRecord("CELL", cellId);
+            m_writer.WriteChunk("DATA", uint16_t{0});
+            EndRecord();
+
+            m_writer.BeginGroup(cellId, PluginWriter::kCellChildren);
+            m_writer.BeginGroup(cellId, PluginWriter::kCellTemporaryChildren);
+
+            for (uint32_t i = world; i < m_settings.NavMeshes; i += m_settings.Worlds)
+            {
+                const int16_t gridX = static_cast<int16_t>(static_cast<int32_t>(i / m_settings.Worlds % 64) - 32);
+                const int16_t gridY = static_cast<int16_t>(static_cast<int32_t>(i / m_settings.Worlds / 64 % 64) - 32);
+                WriteNavMesh(m_ownPrefix | (m_firstNavMeshId + i), worldId, 0, gridX, gridY);
+            }
+
+            m_writer.EndGroup();
+            m_writer.EndGroup();
+            m_writer.EndGroup();
+        }
+
+        m_writer.EndGroup();
+    }
+
+    // A square grid of vertices triangulated as two triangles per quad
+    void WriteNavMesh(uint32_t aFormId, uint32_t aWorldId, uint32_t aCellId, int16_t aGridX, int16_t aGridY) noexcept
+    {
+        const uint32_t side = std::max(2u, static_cast<uint32_t>(std::sqrt(std::min(m_settings.NavMeshVertices, kMaxNavMeshVertices))));
+        constexpr float cSpacing = 4096.f / 16.f;
+
+        Vector<uint8_t> data;
+        auto append = [&data](const void* apData, size_t aSize) {
+            const auto* pData = static_cast<const uint8_t*>(apData);
+            data.insert(data.end(), pData, pData + aSize);
+        };
+
+        const uint32_t version = 12;
+        const uint32_t locationMarker = static_cast<uint32_t>(m_random());
+        append(&version, sizeof(version));
+        append(&locationMarker, sizeof(locationMarker));
+        append(&aWorldId, sizeof(aWorldId));
+        if (aWorldId == 0)
+        {
+            append(&aCellId, sizeof(aCellId));
+        }
+        else
+        {
+            append(&aGridY, sizeof(aGridY));
+            append(&aGridX, sizeof(aGridX));
+        }
+
+        const Vec3 origin{aGridX * 4096.f, aGridY * 4096.f, 0.f};
+        std::uniform_real_distribution<float> height(-64.f, 64.f);
+
+        const int32_t vertexCount = static_cast<int32_t>(side * side);
+        append(&vertexCount, sizeof(vertexCount));
+        for (uint32_t y = 0; y < side; ++y)
+        {
+            for (uint32_t x = 0; x < side; ++x)
+            {
+                const Vec3 vertex{origin.X + x * cSpacing, origin.Y + y * cSpacing, height(m_random)};
+                append(&vertex, sizeof(vertex));
+            }
+        }
+
+        const int32_t triangleCount = static_cast<int32_t>((side - 1) * (side - 1) * 2);
+        append(&triangleCount, sizeof(triangleCount));
+        for (uint32_t y = 0; y + 1 < side; ++y)
+        {
+            for (uint32_t x = 0; x + 1 < side; ++x)
+            {
+                const auto corner = static_cast<int16_t>(y * side + x);
+                const auto stride = static_cast<int16_t>(side);
+
+                const Triangle first{{corner, static_cast<int16_t>(corner + 1), static_cast<int16_t>(corner + stride)}, {-1, -1, -1}, 0, 0};
+                const Triangle second{{static_cast<int16_t>(corner + 1), static_cast<int16_t>(corner + stride + 1), static_cast<int16_t>(corner + stride)},
+                                      {-1, -1, -1}, 0, 0};
+                append(&first, sizeof(first));
+                append(&second, sizeof(second));
+            }
+        }
+
+        // No edge links, door triangles or cover triangles
+        const int32_t none = 0;
+        append(&none, sizeof(none));
+        append(&none, sizeof(none));
+        append(&none, sizeof(none));
+
+        const uint32_t divisor = 8;
+        const float maxDistance[2] = {cSpacing * side, cSpacing * side};
+        const Vec3 min{origin.X, origin.Y, -64.f};
+        const Vec3 max{origin.X + cSpacing * (side - 1), origin.Y + cSpacing * (side - 1), 64.f};
+        append(&divisor, sizeof(divisor));
+        append(maxDistance, sizeof(maxDistance));
+        append(&min, sizeof(min));
+        append(&max, sizeof(max));
+
+        m_writer.BeginRecord("NAVM", aFormId);
+        m_writer.WriteChunk("NVNM", data.data(), data.size());
+        EndRecord();
+    }
+
+    PluginWriter& m_writer;
+    const SyntheticPluginSettings& m_settings;
+    std::mt19937 m_random;
+    uint32_t m_ownPrefix;
+    uint32_t m_nextObjectId;
+
+    uint32_t m_interiorCellCount{0};
+    uint32_t m_firstReferenceId{0};
+    uint32_t m_firstNpcId{0};
+    uint32_t m_firstContainerId{0};
+    uint32_t m_firstWorldId{0};
+    uint32_t m_firstNavMeshId{0};
+    uint32_t m_firstInteriorCellId{0};
+    uint32_t m_firstExteriorCellId{0};
+};
+} // namespace
+
+bool WriteSyntheticPlugin(const std::filesystem::path& acPath, const SyntheticPluginSettings& acSettings,
+                          SyntheticPluginStatistics& aStatistics) noexcept
+{
+    SyntheticPluginSettings settings = acSettings;
+
+    if (settings.Lite)
+    {
+        // Cells are allocated on top of the requested records, keep room for them
+        const uint32_t requested = settings.References + settings.Npcs + settings.Containers + settings.Worlds * 2 + settings.NavMeshes;
+        const uint32_t cells = (settings.References + kReferencesPerCell - 1) / kReferencesPerCell + 1;
+        if (requested + cells > kMaxLiteRecords)
+        {
+            const double scale = static_cast<double>(kMaxLiteRecords - cells) / requested;
+            settings.References = static_cast<uint32_t>(settings.References * scale);
+            settings.Npcs = static_cast<uint32_t>(settings.Npcs * scale);
+            settings.Containers = static_cast<uint32_t>(settings.Containers * scale);
+            settings.Worlds = static_cast<uint32_t>(settings.Worlds * scale);
+            settings.NavMeshes = static_cast<uint32_t>(settings.NavMeshes * scale);
+        }
+    }
+
+    PluginWriter writer(acPath);
+    if (!writer.IsOpen())
+        return false;
+
+    Generator generator(writer, settings);
+    generator.Write();
+
+    aStatistics.Bytes = writer.GetSize();
+    aStatistics.Records = writer.GetRecordCount();
+
+    return writer.Close();
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <TiltedCore/Stl.hpp>
+
+#include <filesystem>
+
+using TiltedPhoques::String;
+using TiltedPhoques::Vector;
+
+struct SyntheticPluginSettings
+{
+    uint32_t References{0};
+    uint32_t Npcs{0};
+    uint32_t Containers{0};
+    uint32_t Worlds{0};
+    // Spread over the worlds, or over interior cells when there are none
+    uint32_t NavMeshes{0};
+    uint32_t NavMeshVertices{64};
+    // Every Nth record gets zlib compressed, 0 disables compression
+    uint32_t CompressEvery{0};
+    // Share of references overriding the first master's references instead of adding new ones
+    uint32_t OverridePercent{0};
+    bool Master{false};
+    bool Lite{false};
+    Vector<String> Masters{};
+    uint32_t Seed{0};
+};
+
+struct SyntheticPluginStatistics
+{
+    uint64_t Bytes{0};
+    uint32_t Records{0};
+};
+
+// Light plugins can only address this many records of their own
+constexpr uint32_t kMaxLiteRecords = 0x800;
+
+/**
+* @brief Writes a format valid plugin filled with generated REFR, NPC_, CONT, WRLD and NAVM records.
+*
+* Records are laid out the way the creation kit does it: references and interior nav meshes inside interior
+* cell children, exterior nav meshes inside world children. The content is meaningless but every chunk the
+* loader parses is present and well formed.
+*/
+bool WriteSyntheticPlugin(const std::filesystem::path& acPath, const SyntheticPluginSettings& acSettings,
+                          SyntheticPluginStatistics& aStatistics) noexcept;
@@ -0,0 +1,288 @@
+#include <es_loader/stdafx.h>
+
+#include "SyntheticPlugin.h"
+
+#include <es_loader/ESLoader.h>
+#include <es_loader/RecordCollection.h>
+
+#include <console/CommandSettingsProvider.h>
+#include <console/ConsoleRegistry.h>
+#include <console/Setting.h>
+
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <spdlog/spdlog.h>
+
+#include <chrono>
+#include <fstream>
+#include <limits>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace fs = std::filesystem;
+
+// Settings are passed on the command line, e.g. ESLoaderBenchmark --uPlugins=32 --uReferences=20000 --uCompressEvery=4
+namespace
+{
+constexpr char kLoggerName[] = "ESLoaderBench";
+constexpr char kMasterName[] = "SyntheticMaster.esm";
+
+Console::StringSetting sDirectory{"sDirectory", "Directory the synthetic plugins and load order are written to", "SyntheticData"};
+Console::Setting bGenerate{"bGenerate", "Write the plugins before loading, disable to reuse a previous data set", true};
+Console::Setting uSeed{"uSeed", "Seed of the generated content", 1u};
+
+Console::Setting uPlugins{"uPlugins", "Number of .esp plugins loaded after the master", 16u};
+Console::Setting uLitePlugins{"uLitePlugins", "Number of .esl plugins loaded last", 8u};
+Console::Setting uMasterScale{"uMasterScale", "The master holds this many times the records of a plugin", 10u};
+
+Console::Setting uReferences{"uReferences", "REFR records per plugin", 10000u};
+Console::Setting uNpcs{"uNpcs", "NPC_ records per plugin", 1000u};
+Console::Setting uContainers{"uContainers", "CONT records per plugin", 500u};
+Console::Setting uWorlds{"uWorlds", "WRLD records per plugin", 2u};
+Console::Setting uNavMeshes{"uNavMeshes", "NAVM records per plugin", 500u};
+Console::Setting uNavMeshVertices{"uNavMeshVertices", "Vertices per nav mesh", 64u};
+Console::Setting uCompressEvery{"uCompressEvery", "Compress every Nth record (0 to disable)", 4u};
+Console::Setting uOverridePercent{"uOverridePercent", "Percentage of plugin references overriding master references", 25u};
+
+Console::Setting uIterations{"uIterations", "Number of timed loads", 3u};
+Console::Setting bParse{"bParse", "Parse every indexed record after each load", true};
+Console::Setting bCache{"bCache", "Also time a load from the record cache", true};
+
+struct LoadResult
+{
+    double IndexSeconds{0.0};
+    double ParseSeconds{0.0};
+    size_t Records{0};
+    size_t Parsed{0};
+};
+
+uint64_t GetPeakMemory() noexcept
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return counters.PeakWorkingSetSize;
+    return 0;
+#else
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    // Reported in KiB on Linux
+    return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+}
+
+SyntheticPluginSettings MakeSettings(uint32_t aScale) noexcept
+{
+    SyntheticPluginSettings settings{};
+    settings.References = uReferences.value_as<uint32_t>() * aScale;
+    settings.Npcs = uNpcs.value_as<uint32_t>() * aScale;
+    settings.Containers = uContainers.value_as<uint32_t>() * aScale;
+    settings.Worlds = uWorlds.value_as<uint32_t>() * aScale;
+    settings.NavMeshes = uNavMeshes.value_as<uint32_t>() * aScale;
+    settings.NavMeshVertices = uNavMeshVertices.value_as<uint32_t>();
+    settings.CompressEvery = uCompressEvery.value_as<uint32_t>();
+    return settings;
+}
+
+bool Generate(const fs::path& acDirectory, uint64_t& aBytes) noexcept
+{
+    std::error_code error;
+    fs::create_directories(acDirectory, error);
+    if (error)
+    {
+        spdlog::error("Failed to create {}: {}", acDirectory.string(), error.message());
+        return false;
+    }
+
+    std::ofstream loadOrder(acDirectory / "loadorder.txt", std::ios::trunc);
+    if (!loadOrder)
+    {
+        spdlog::error("Failed to write the load order in {}", acDirectory.string());
+        return false;
+    }
+
+    const uint32_t seed = uSeed.value_as<uint32_t>();
+    const uint32_t pluginCount = uPlugins.value_as<uint32_t>();
+    const uint32_t litePluginCount = uLitePlugins.value_as<uint32_t>();
+
+    const auto start = std::chrono::steady_clock::now();
+    uint32_t records = 0;
+    aBytes = 0;
+
+    auto write = [&](const String& acFilename, const SyntheticPluginSettings& acSettings) {
+        SyntheticPluginStatistics statistics{};
+        if (!WriteSyntheticPlugin(acDirectory / acFilename.c_str(), acSettings, statistics))
+        {
+            spdlog::error("Failed to write {}", acFilename);
+            return false;
+        }
+
+        loadOrder << acFilename << '\n';
+        aBytes += statistics.Bytes;
+        records += statistics.Records;
+        return true;
+    };
+
+    SyntheticPluginSettings master = MakeSettings(std::max(uMasterScale.value_as<uint32_t>(), 1u));
+    master.Master = true;
+    master.Seed = seed;
+    if (!write(kMasterName, master))
+        return false;
+
+    for (uint32_t i = 0; i < pluginCount + litePluginCount; ++i)
+    {
+        const bool lite = i >= pluginCount;
+
+        SyntheticPluginSettings plugin = MakeSettings(1);
+        plugin.Lite = lite;
+        plugin.OverridePercent = uOverridePercent.value_as<uint32_t>();
+        plugin.Masters.push_back(kMasterName);
+        plugin.Seed = seed + i + 1;
+
+        const String filename = fmt::format("SyntheticPlugin{:03}.{}", i, lite ? "esl" : "esp").c_str();
+        if (!write(filename, plugin))
+            return false;
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    spdlog::info("Generated {} plugins, {} records, {:.1f} MiB in {:.2f}s", pluginCount + litePluginCount + 1, records,
+                 aBytes / (1024.0 * 1024.0), seconds);
+
+    return true;
+}
+
+uint64_t GetDataSize(const fs::path& acDirectory) noexcept
+{
+    uint64_t bytes = 0;
+    std::error_code error;
+    for (const auto& entry : fs::directory_iterator(acDirectory, error))
+    {
+        const auto extension = entry.path().extension();
+        if (extension == ".esm" || extension == ".esp" || extension == ".esl")
+            bytes += entry.file_size(error);
+    }
+    return bytes;
+}
+
+// Touches every record of the types the loader knows how to parse, which inflates the compressed ones
+size_t ParseAll(ESLoader::RecordCollection& aCollection) noexcept
+{
+    size_t parsed = 0;
+
+    for (uint32_t formId : aCollection.GetFormIdsOfType(FormEnum::REFR))
+        parsed += aCollection.GetObjectRefById(formId).GetFormId() == formId;
+    for (uint32_t formId : aCollection.GetFormIdsOfType(FormEnum::NPC_))
+        parsed += aCollection.GetNpcById(formId).GetFormId() == formId;
+    for (uint32_t formId : aCollection.GetFormIdsOfType(FormEnum::CONT))
+        parsed += aCollection.GetContainerById(formId).GetFormId() == formId;
+    for (uint32_t formId : aCollection.GetFormIdsOfType(FormEnum::NAVM))
+        parsed += aCollection.GetNavMeshById(formId).GetFormId() == formId;
+    for (uint32_t formId : aCollection.GetFormIdsOfType(FormEnum::WRLD))
+        parsed += aCollection.GetWorldById(formId).GetFormId() == formId;
+
+    return parsed;
+}
+
+bool Load(const fs::path& acDirectory, const fs::path& acCachePath, LoadResult& aResult) noexcept
+{
+    using namespace std::chrono;
+
+    ESLoader::ESLoader loader(acDirectory);
+    loader.SetCachePath(acCachePath);
+
+    const auto start = steady_clock::now();
+    auto pCollection = loader.BuildRecordCollection();
+    aResult.IndexSeconds = duration<double>(steady_clock::now() - start).count();
+
+    if (!pCollection)
+    {
+        spdlog::error("Failed to load {}", acDirectory.string());
+        return false;
+    }
+
+    aResult.Records = pCollection->GetRecordCount();
+
+    if (bParse)
+    {
+        const auto parseStart = steady_clock::now();
+        aResult.Parsed = ParseAll(*pCollection);
+        aResult.ParseSeconds = duration<double>(steady_clock::now() - parseStart).count();
+    }
+
+    return true;
+}
+
+void Report(const char* acpLabel, const LoadResult& acResult, uint64_t aBytes) noexcept
+{
+    const double megabytes = aBytes / (1024.0 * 1024.0);
+
+    spdlog::info("{}: {} records indexed in {:.3f}s, {:.1f} MiB/s, {:.0f} records/s", acpLabel, acResult.Records, acResult.IndexSeconds,
+                 megabytes / acResult.IndexSeconds, acResult.Records / acResult.IndexSeconds);
+
+    if (bParse)
+        spdlog::info("  {} records parsed in {:.3f}s, {:.0f} records/s", acResult.Parsed, acResult.ParseSeconds,
+                     acResult.Parsed / acResult.ParseSeconds);
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto pLogger = spdlog::stdout_color_mt(kLoggerName);
+    pLogger->set_pattern("%^[%H:%M:%S] [%l]%$ %v");
+    spdlog::set_default_logger(pLogger);
+
+    Console::ConsoleRegistry registry(kLoggerName);
+    Console::LoadSettingsFromCommand(registry, argc, argv);
+
+    const fs::path directory = fs::absolute(sDirectory.c_str());
+
+    uint64_t bytes = 0;
+    if (bGenerate)
+    {
+        if (!Generate(directory, bytes))
+            return 1;
+    }
+    else
+    {
+        bytes = GetDataSize(directory);
+    }
+
+    const uint32_t iterations = std::max(uIterations.value_as<uint32_t>(), 1u);
+    LoadResult best{};
+    best.IndexSeconds = std::numeric_limits<double>::max();
+
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        // Each run builds its own collection, nothing parsed or inflated by the previous one is reused
+        LoadResult result{};
+        if (!Load(directory, {}, result))
+            return 1;
+
+        if (result.IndexSeconds < best.IndexSeconds)
+            best = result;
+    }
+
+    Report("Cold index", best, bytes);
+
+    if (bCache)
+    {
+        const fs::path cachePath = directory / "RecordCache.bin";
+        std::error_code error;
+        fs::remove(cachePath, error);
+
+        // The first load writes the cache, the second one reads it
+        LoadResult result{};
+        if (!Load(directory, cachePath, result) || !Load(directory, cachePath, result))
+            return 1;
+
+        Report("Cached index", result, bytes);
+    }
+
+    spdlog::info("Peak memory: {:.1f} MiB", GetPeakMemory() / (1024.0 * 1024.0));
+
+    return 0;
+}
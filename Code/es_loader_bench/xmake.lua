@@ -0,0 +1,24 @@
+
+target("ESLoaderBenchmark")
+    set_basename("TPESLoaderBenchmark")
+    set_kind("binary")
+    set_group("Tests")
+    add_includedirs(
+        ".",
+        "../")
+    add_headerfiles("**.h")
+    add_files("**.cpp")
+    add_deps(
+        "ESLoader",
+        "Console")
+    add_packages(
+        "tiltedcore",
+        "spdlog",
+        "hopscotch-map",
+        "glm",
+        "zlib")
+    add_defines("SPDLOG_HEADER_ONLY")
+
+    if is_plat("windows") then
+        add_syslinks("psapi")
+    end
@@ -0,0 +1,350 @@
+#include "Bot.h"
+
+#include <BuildInfo.h>
+#include <Packet.hpp>
+
+#include <Messages/AssignCharacterRequest.h>
+#include <Messages/AuthenticationRequest.h>
+#include <Messages/ClientReferencesMoveRequest.h>
+#include <Messages/EnterExteriorCellRequest.h>
+#include <Messages/PartyAcceptInviteRequest.h>
+#include <Messages/PartyCreateRequest.h>
+#include <Messages/PartyInviteRequest.h>
+#include <Messages/SendChatMessageRequest.h>
+#include <Messages/ServerMessageFactory.h>
+#include <MessageBundle.h>
+
+#include <spdlog/spdlog.h>
+
+#include <charconv>
+#include <cmath>
+
+namespace
+{
+constexpr char kChatPrefix[] = "loadgen:";
+// The server treats this reference id as the local player
+const GameId kPlayerReferenceId{0, 0x14};
+
+glm::vec3 GetSpawnPoint(uint32_t aIndex, const BotSettings& acSettings) noexcept
+{
+    // Golden angle spiral, spreads any number of bots evenly over the disc
+    constexpr float cGoldenAngle = 2.39996323f;
+
+    const float cAngle = static_cast<float>(aIndex) * cGoldenAngle;
+    const float cDistance = acSettings.SpawnSpread * std::sqrt(static_cast<float>(aIndex % 256) / 256.f);
+
+    return acSettings.Origin + glm::vec3{std::cos(cAngle) * cDistance, std::sin(cAngle) * cDistance, 0.f};
+}
+
+uint64_t NowMicroseconds() noexcept
+{
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+} // namespace
+
+void BotStatistics::Reset() noexcept
+{
+    BytesSent = 0;
+    BytesReceived = 0;
+    MessagesSent = 0;
+    MessagesReceived = 0;
+    PacketsReceived = 0;
+    ChatLatencies.clear();
+    SnapshotIntervals.clear();
+}
+
+Bot::Bot(uint32_t aIndex, const BotSettings& acSettings) noexcept
+    : m_index(aIndex)
+    , m_settings(acSettings)
+    , m_username(fmt::format("Bot {}", aIndex).c_str())
+    , m_pattern(acSettings.Pattern, GetSpawnPoint(aIndex, acSettings), acSettings.Radius, acSettings.Speed, aIndex)
+    , m_sendBuffer(1 << 16)
+{
+}
+
+bool Bot::Start() noexcept
+{
+    m_state = State::kConnecting;
+    return Connect(m_settings.Endpoint);
+}
+
+void Bot::Update(std::chrono::steady_clock::time_point aNow) noexcept
+{
+    Client::Update();
+
+    const auto cDelta = m_lastUpdate.time_since_epoch().count() ? aNow - m_lastUpdate : std::chrono::steady_clock::duration::zero();
+    m_lastUpdate = aNow;
+
+    if (m_state != State::kInWorld)
+        return;
+
+    m_pattern.Advance(std::chrono::duration<float>(cDelta).count());
+
+    if (aNow >= m_nextMove)
+    {
+        SendMovement();
+        m_nextMove = aNow + m_settings.MoveInterval;
+    }
+
+    if (m_settings.ChatInterval.count() > 0 && aNow >= m_nextChat)
+    {
+        SendChat();
+        m_nextChat = aNow + m_settings.ChatInterval;
+    }
+
+    if (!m_partyMembers.empty() && !m_partyRequested)
+    {
+        m_partyRequested = true;
+        Send(PartyCreateRequest{});
+    }
+}
+
+void Bot::SetPartyMembers(Vector<uint32_t> aPlayerIds) noexcept
+{
+    m_partyMembers = std::move(aPlayerIds);
+}
+
+void Bot::OnConsume(const void* apData, uint32_t aSize)
+{
+    m_statistics.BytesReceived += aSize;
+    ++m_statistics.PacketsReceived;
+
+    if (MessageBundle::IsBundle(apData, aSize))
+    {
+        if (!MessageBundle::ForEach(apData, aSize, [this](const uint8_t* apMessage, size_t aMessageSize) { HandleMessage(apMessage, aMessageSize); }))
+            spdlog::error("{} couldn't parse message bundle from server", m_username.c_str());
+
+        return;
+    }
+
+    HandleMessage(apData, aSize);
+}
+
+void Bot::HandleMessage(const void* apData, size_t aSize) noexcept
+{
+    ++m_statistics.MessagesReceived;
+
+    ServerMessageFactory factory;
+    TiltedPhoques::ViewBuffer buf((uint8_t*)apData, aSize);
+    TiltedPhoques::Buffer::Reader reader(&buf);
+
+    auto pMessage = factory.Extract(reader);
+    if (!pMessage)
+    {
+        spdlog::error("{} couldn't parse packet from server", m_username.c_str());
+        return;
+    }
+
+    switch (pMessage->GetOpcode())
+    {
+    case AuthenticationResponse::Opcode:
+        HandleAuthenticationResponse(static_cast<const AuthenticationResponse&>(*pMessage));
+        break;
+    case AssignCharacterResponse::Opcode:
+        HandleAssignCharacterResponse(static_cast<const AssignCharacterResponse&>(*pMessage));
+        break;
+    case ServerReferencesMoveRequest::Opcode:
+        HandleMovement(static_cast<const ServerReferencesMoveRequest&>(*pMessage));
+        break;
+    case NotifyChatMessageBroadcast::Opcode:
+        HandleChat(static_cast<const NotifyChatMessageBroadcast&>(*pMessage));
+        break;
+    case NotifyPartyInvite::Opcode:
+        HandlePartyInvite(static_cast<const NotifyPartyInvite&>(*pMessage));
+        break;
+    case NotifyPartyJoined::Opcode:
+        HandlePartyJoined(static_cast<const NotifyPartyJoined&>(*pMessage));
+        break;
+    case NotifyPartyLeft::Opcode:
+        m_inParty = false;
+        break;
+    default:
+        break;
+    }
+}
+
+void Bot::OnConnected()
+{
+    m_state = State::kAuthenticating;
+
+    AuthenticationRequest request{};
+    request.Version = BUILD_COMMIT;
+    request.Token = m_settings.Password;
+    request.Username = m_username;
+    request.WorldSpaceId = m_settings.WorldSpaceId;
+    request.CellId = m_settings.CellId;
+    request.Level = 1;
+
+    Send(request);
+}
+
+void Bot::OnDisconnected(EDisconnectReason aReason)
+{
+    spdlog::warn("{} disconnected from server {}", m_username.c_str(), aReason);
+
+    if (m_state != State::kRejected)
+        m_state = State::kIdle;
+
+    m_gridCell.reset();
+    m_inParty = false;
+    m_partyRequested = false;
+}
+
+void Bot::OnUpdate()
+{
+}
+
+bool Bot::Send(const ClientMessage& acMessage) noexcept
+{
+    if (!IsConnected())
+        return false;
+
+    TiltedPhoques::Buffer::Writer writer(&m_sendBuffer);
+    writer.WriteBits(0, 8); // Write first byte as packet needs it
+
+    acMessage.Serialize(writer);
+    TiltedPhoques::PacketView packet(reinterpret_cast<char*>(m_sendBuffer.GetWriteData()), writer.Size());
+
+    Client::Send(&packet);
+
+    m_statistics.BytesSent += writer.Size();
+    ++m_statistics.MessagesSent;
+
+    return true;
+}
+
+void Bot::SendMovement() noexcept
+{
+    const auto& cPosition = m_pattern.GetPosition();
+
+    const auto cGridCell = GridCellCoords::CalculateGridCellCoords(cPosition.x, cPosition.y);
+    if (!m_gridCell || *m_gridCell != cGridCell)
+    {
+        m_gridCell = cGridCell;
+
+        EnterExteriorCellRequest request{};
+        request.WorldSpaceId = m_settings.WorldSpaceId;
+        request.CellId = m_settings.CellId;
+        request.CurrentCoords = cGridCell;
+        Send(request);
+    }
+
+    ClientReferencesMoveRequest message{};
+    message.Tick = GetClock().GetCurrentTick();
+
+    auto& movement = message.Updates[m_serverId].UpdatedMovement;
+    movement.CellId = m_settings.CellId;
+    movement.WorldSpaceId = m_settings.WorldSpaceId;
+    movement.Position.x = cPosition.x;
+    movement.Position.y = cPosition.y;
+    movement.Position.z = cPosition.z;
+    movement.Rotation.y = m_pattern.GetHeading();
+    movement.Direction = m_pattern.IsMoving() ? 1.f : 0.f;
+
+    Send(message);
+}
+
+void Bot::SendChat() noexcept
+{
+    SendChatMessageRequest request{};
+    request.MessageType = m_inParty ? kPartyChat : kGlobalChat;
+    request.ChatMessage = fmt::format("{}{}:{}", kChatPrefix, m_index, NowMicroseconds()).c_str();
+
+    Send(request);
+}
+
+void Bot::HandleAuthenticationResponse(const AuthenticationResponse& acMessage) noexcept
+{
+    if (acMessage.Type != AuthenticationResponse::ResponseType::kAccepted)
+    {
+        spdlog::error("{} was rejected by the server, reason {}", m_username.c_str(), static_cast<uint32_t>(acMessage.Type));
+        m_state = State::kRejected;
+        Close();
+        return;
+    }
+
+    m_playerId = acMessage.PlayerId;
+    m_state = State::kAssigning;
+
+    const auto& cPosition = m_pattern.GetPosition();
+
+    AssignCharacterRequest request{};
+    request.Cookie = m_index;
+    request.ReferenceId = kPlayerReferenceId;
+    request.CellId = m_settings.CellId;
+    request.WorldSpaceId = m_settings.WorldSpaceId;
+    request.Position.x = cPosition.x;
+    request.Position.y = cPosition.y;
+    request.Position.z = cPosition.z;
+
+    Send(request);
+}
+
+void Bot::HandleAssignCharacterResponse(const AssignCharacterResponse& acMessage) noexcept
+{
+    if (acMessage.Cookie != m_index || m_state != State::kAssigning)
+        return;
+
+    m_serverId = acMessage.ServerId;
+    m_state = State::kInWorld;
+
+    // Spread the first sends so bots started together don't all hit the same server tick
+    const auto cNow = std::chrono::steady_clock::now();
+    m_nextMove = cNow + m_settings.MoveInterval * (m_index % 8) / 8;
+    m_nextChat = cNow + m_settings.ChatInterval * (m_index % 16) / 16;
+}
+
+void Bot::HandleMovement(const ServerReferencesMoveRequest& acMessage) noexcept
+{
+    if (m_lastSnapshotTick != 0 && acMessage.Tick > m_lastSnapshotTick)
+        m_statistics.SnapshotIntervals.push_back(static_cast<uint32_t>(acMessage.Tick - m_lastSnapshotTick));
+
+    m_lastSnapshotTick = acMessage.Tick;
+}
+
+void Bot::HandleChat(const NotifyChatMessageBroadcast& acMessage) noexcept
+{
+    // Only our own messages carry a send time we can compare against
+    std::string_view text(acMessage.ChatMessage.c_str(), acMessage.ChatMessage.size());
+    if (!text.starts_with(kChatPrefix))
+        return;
+
+    text.remove_prefix(std::size(kChatPrefix) - 1);
+
+    const auto cSeparator = text.find(':');
+    if (cSeparator == std::string_view::npos)
+        return;
+
+    uint32_t index = 0;
+    uint64_t sendTime = 0;
+    std::from_chars(text.data(), text.data() + cSeparator, index);
+    std::from_chars(text.data() + cSeparator + 1, text.data() + text.size(), sendTime);
+
+    if (index != m_index || sendTime == 0)
+        return;
+
+    m_statistics.ChatLatencies.push_back(static_cast<uint32_t>(NowMicroseconds() - sendTime));
+}
+
+void Bot::HandlePartyInvite(const NotifyPartyInvite& acMessage) noexcept
+{
+    PartyAcceptInviteRequest request{};
+    request.InviterId = acMessage.InviterId;
+    Send(request);
+}
+
+void Bot::HandlePartyJoined(const NotifyPartyJoined& acMessage) noexcept
+{
+    m_inParty = true;
+
+    if (!acMessage.IsLeader)
+        return;
+
+    for (const uint32_t cPlayerId : m_partyMembers)
+    {
+        PartyInviteRequest request{};
+        request.PlayerId = cPlayerId;
+        Send(request);
+    }
+}
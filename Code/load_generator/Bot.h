@@ -0,0 +1,133 @@
+#pragma once
+
+#include "MovementPattern.h"
+
+#include <Client.hpp>
+#include <Structs/GameId.h>
+#include <Structs/GridCellCoords.h>
+
+#include <chrono>
+#include <optional>
+
+struct ClientMessage;
+struct ServerMessage;
+struct AuthenticationResponse;
+struct AssignCharacterResponse;
+struct ServerReferencesMoveRequest;
+struct NotifyChatMessageBroadcast;
+struct NotifyPartyInvite;
+struct NotifyPartyJoined;
+
+using TiltedPhoques::Client;
+using TiltedPhoques::String;
+using TiltedPhoques::Vector;
+
+struct BotSettings
+{
+    std::string Endpoint{};
+    String Password{};
+    MovementPattern::Type Pattern{MovementPattern::kWander};
+    glm::vec3 Origin{};
+    // Bots spawn evenly spread on a disc of this radius around Origin
+    float SpawnSpread{};
+    float Radius{};
+    float Speed{};
+    GameId WorldSpaceId{};
+    GameId CellId{};
+    std::chrono::milliseconds MoveInterval{};
+    // 0 disables chat traffic
+    std::chrono::milliseconds ChatInterval{};
+};
+
+struct BotStatistics
+{
+    void Reset() noexcept;
+
+    uint64_t BytesSent{0};
+    uint64_t BytesReceived{0};
+    uint64_t MessagesSent{0};
+    uint64_t MessagesReceived{0};
+    // The server bundles the messages of a tick, so this is usually well below MessagesReceived
+    uint64_t PacketsReceived{0};
+    // Round trip of our own chat messages, in microseconds
+    Vector<uint32_t> ChatLatencies{};
+    // Server tick delta between consecutive movement snapshots, in milliseconds
+    Vector<uint32_t> SnapshotIntervals{};
+};
+
+/**
+* @brief Headless player speaking the game protocol.
+*
+* Authenticates, assigns a player character, then streams movement and optional chat and party traffic.
+*/
+struct Bot final : Client
+{
+    enum class State : uint8_t
+    {
+        kIdle,
+        kConnecting,
+        kAuthenticating,
+        kAssigning,
+        kInWorld,
+        kRejected
+    };
+
+    Bot(uint32_t aIndex, const BotSettings& acSettings) noexcept;
+    ~Bot() noexcept override = default;
+
+    TP_NOCOPYMOVE(Bot);
+
+    bool Start() noexcept;
+    void Update(std::chrono::steady_clock::time_point aNow) noexcept;
+
+    // Leader only, the party is created and the players invited once the bot is in world
+    void SetPartyMembers(Vector<uint32_t> aPlayerIds) noexcept;
+
+    [[nodiscard]] State GetState() const noexcept { return m_state; }
+    [[nodiscard]] bool IsInWorld() const noexcept { return m_state == State::kInWorld; }
+    [[nodiscard]] uint32_t GetPlayerId() const noexcept { return m_playerId; }
+    [[nodiscard]] bool HasPartyMembers() const noexcept { return !m_partyMembers.empty(); }
+    [[nodiscard]] BotStatistics& GetStatistics() noexcept { return m_statistics; }
+
+    // Implement TiltedPhoques::Client
+    void OnConsume(const void* apData, uint32_t aSize) override;
+    void OnConnected() override;
+    void OnDisconnected(EDisconnectReason aReason) override;
+    void OnUpdate() override;
+
+private:
+    bool Send(const ClientMessage& acMessage) noexcept;
+
+    void SendMovement() noexcept;
+    void SendChat() noexcept;
+
+    void HandleMessage(const void* apData, size_t aSize) noexcept;
+    void HandleAuthenticationResponse(const AuthenticationResponse& acMessage) noexcept;
+    void HandleAssignCharacterResponse(const AssignCharacterResponse& acMessage) noexcept;
+    void HandleMovement(const ServerReferencesMoveRequest& acMessage) noexcept;
+    void HandleChat(const NotifyChatMessageBroadcast& acMessage) noexcept;
+    void HandlePartyInvite(const NotifyPartyInvite& acMessage) noexcept;
+    void HandlePartyJoined(const NotifyPartyJoined& acMessage) noexcept;
+
+    uint32_t m_index;
+    const BotSettings& m_settings;
+    String m_username;
+    State m_state{State::kIdle};
+
+    uint32_t m_playerId{0};
+    uint32_t m_serverId{0};
+    MovementPattern m_pattern;
+    std::optional<GridCellCoords> m_gridCell{};
+
+    bool m_inParty{false};
+    bool m_partyRequested{false};
+    Vector<uint32_t> m_partyMembers{};
+
+    std::chrono::steady_clock::time_point m_lastUpdate{};
+    std::chrono::steady_clock::time_point m_nextMove{};
+    std::chrono::steady_clock::time_point m_nextChat{};
+    uint64_t m_lastSnapshotTick{0};
+
+    TiltedPhoques::Buffer m_sendBuffer;
+    BotStatistics m_statistics{};
+};
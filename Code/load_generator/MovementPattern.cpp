@@ -0,0 +1,101 @@
+#include "MovementPattern.h"
+
+#include <glm/geometric.hpp>
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+MovementPattern::MovementPattern(Type aType, const glm::vec3& acSpawn, float aRadius, float aSpeed, uint32_t aSeed) noexcept
+    : m_type(aType)
+    , m_spawn(acSpawn)
+    , m_position(acSpawn)
+    , m_radius(std::max(aRadius, 1.f))
+    , m_speed(aSpeed)
+    , m_random(aSeed)
+{
+    std::uniform_real_distribution<float> angle(0.f, glm::two_pi<float>());
+    m_phase = angle(m_random);
+
+    if (m_type == kWander)
+        PickWanderTarget();
+}
+
+std::optional<MovementPattern::Type> MovementPattern::Parse(std::string_view aName) noexcept
+{
+    if (aName == "idle")
+        return kIdle;
+    if (aName == "circle")
+        return kCircle;
+    if (aName == "wander")
+        return kWander;
+    if (aName == "patrol")
+        return kPatrol;
+
+    return std::nullopt;
+}
+
+void MovementPattern::Advance(float aDeltaSeconds) noexcept
+{
+    const glm::vec2 cPrevious{m_position.x, m_position.y};
+
+    switch (m_type)
+    {
+    case kIdle:
+        return;
+
+    case kCircle:
+    {
+        m_phase += m_speed * aDeltaSeconds / m_radius;
+        m_position.x = m_spawn.x + std::cos(m_phase) * m_radius;
+        m_position.y = m_spawn.y + std::sin(m_phase) * m_radius;
+        break;
+    }
+
+    case kWander:
+    {
+        const glm::vec2 cPosition{m_position.x, m_position.y};
+        const glm::vec2 cToTarget = m_target - cPosition;
+        const float cDistance = glm::length(cToTarget);
+        const float cStep = m_speed * aDeltaSeconds;
+
+        if (cDistance <= cStep)
+        {
+            m_position.x = m_target.x;
+            m_position.y = m_target.y;
+            PickWanderTarget();
+        }
+        else
+        {
+            const glm::vec2 cNext = cPosition + cToTarget * (cStep / cDistance);
+            m_position.x = cNext.x;
+            m_position.y = cNext.y;
+        }
+        break;
+    }
+
+    case kPatrol:
+    {
+        // Back and forth along a line through the spawn point, long enough to cross grid cells
+        m_phase += m_speed * aDeltaSeconds / m_radius;
+        m_position.x = m_spawn.x + std::sin(m_phase) * m_radius;
+        break;
+    }
+    }
+
+    const glm::vec2 cDelta = glm::vec2{m_position.x, m_position.y} - cPrevious;
+    if (glm::length(cDelta) > 0.f)
+        m_heading = std::atan2(cDelta.x, cDelta.y);
+}
+
+void MovementPattern::PickWanderTarget() noexcept
+{
+    std::uniform_real_distribution<float> angle(0.f, glm::two_pi<float>());
+    std::uniform_real_distribution<float> distance(0.f, 1.f);
+
+    const float cAngle = angle(m_random);
+    // sqrt keeps targets evenly spread over the disc instead of bunched at the center
+    const float cDistance = std::sqrt(distance(m_random)) * m_radius;
+
+    m_target = {m_spawn.x + std::cos(cAngle) * cDistance, m_spawn.y + std::sin(cAngle) * cDistance};
+}
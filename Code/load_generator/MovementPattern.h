@@ -0,0 +1,50 @@
+#pragma once
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <optional>
+#include <random>
+#include <string_view>
+
+/**
+* @brief Generates the position of a simulated player over time.
+*
+* All patterns stay within aRadius of the spawn point so bots stay in replication range of each other
+* unless the radius is made larger than the grid window.
+*/
+struct MovementPattern
+{
+    enum Type : uint8_t
+    {
+        kIdle,
+        kCircle,
+        kWander,
+        kPatrol
+    };
+
+    MovementPattern(Type aType, const glm::vec3& acSpawn, float aRadius, float aSpeed, uint32_t aSeed) noexcept;
+
+    static std::optional<Type> Parse(std::string_view aName) noexcept;
+
+    // Advances the pattern by aDeltaSeconds
+    void Advance(float aDeltaSeconds) noexcept;
+
+    [[nodiscard]] const glm::vec3& GetPosition() const noexcept { return m_position; }
+    // Yaw in radians, facing the direction of travel
+    [[nodiscard]] float GetHeading() const noexcept { return m_heading; }
+    [[nodiscard]] bool IsMoving() const noexcept { return m_type != kIdle; }
+
+private:
+    void PickWanderTarget() noexcept;
+
+    Type m_type;
+    glm::vec3 m_spawn;
+    glm::vec3 m_position;
+    glm::vec2 m_target{};
+    float m_radius;
+    float m_speed;
+    float m_phase{0.f};
+    float m_heading{0.f};
+    std::mt19937 m_random;
+};
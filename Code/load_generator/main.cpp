@@ -0,0 +1,278 @@
+
+#include "Bot.h"
+
+#include <console/CommandSettingsProvider.h>
+#include <console/ConsoleRegistry.h>
+#include <console/Setting.h>
+#include <base/threading/ThreadUtils.h>
+
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <numeric>
+#include <thread>
+
+#if defined(__linux__)
+#include <signal.h>
+#endif
+
+using TiltedPhoques::MakeUnique;
+using TiltedPhoques::UniquePtr;
+
+// Settings are passed on the command line, e.g. LoadGenerator --uBotCount=64 --sPattern=circle
+namespace
+{
+constexpr char kLoggerName[] = "LoadGen";
+
+Console::StringSetting sEndpoint{"sEndpoint", "Server address", "127.0.0.1:10578"};
+Console::StringSetting sPassword{"sPassword", "Server password", ""};
+Console::Setting uBotCount{"uBotCount", "Number of simulated players", 16u};
+Console::Setting uConnectRate{"uConnectRate", "Bots connected per second while ramping up", 10u};
+Console::Setting uDuration{"uDuration", "Seconds to run for once all bots are started (0 runs until interrupted)", 60u};
+Console::Setting uReportInterval{"uReportInterval", "Seconds between reports", 5u};
+Console::Setting uUpdateRate{"uUpdateRate", "Client frames per second", 60u};
+
+Console::StringSetting sPattern{"sPattern", "Movement pattern: idle, circle, wander or patrol", "wander"};
+Console::Setting fRadius{"fRadius", "Radius of the movement pattern in game units", 2048.f};
+Console::Setting fSpeed{"fSpeed", "Movement speed in game units per second", 350.f};
+Console::Setting fSpawnSpread{"fSpawnSpread", "Radius of the disc the bots spawn on", 4096.f};
+Console::Setting fOriginX{"fOriginX", "Spawn disc center X", 0.f};
+Console::Setting fOriginY{"fOriginY", "Spawn disc center Y", 0.f};
+Console::Setting fOriginZ{"fOriginZ", "Spawn disc center Z", 0.f};
+Console::Setting uWorldSpaceId{"uWorldSpaceId", "World space base id in the master file", 0x3Cu};
+Console::Setting uCellId{"uCellId", "Cell base id in the master file", 0x9732u};
+
+Console::Setting uMoveInterval{"uMoveInterval", "Milliseconds between movement updates", 100u};
+Console::Setting uChatInterval{"uChatInterval", "Milliseconds between chat messages per bot (0 to disable)", 5000u};
+Console::Setting uPartySize{"uPartySize", "Bots per party (0 or 1 to disable parties)", 0u};
+
+std::atomic<bool> s_stopRequested{false};
+
+uint32_t Percentile(Vector<uint32_t>& aSamples, uint32_t aPercentile) noexcept
+{
+    if (aSamples.empty())
+        return 0;
+
+    const size_t cIndex = std::min(aSamples.size() * aPercentile / 100, aSamples.size() - 1);
+    std::nth_element(aSamples.begin(), aSamples.begin() + cIndex, aSamples.end());
+
+    return aSamples[cIndex];
+}
+
+void RegisterQuitHandler() noexcept
+{
+#if defined(__linux__)
+    signal(SIGINT, [](int) { s_stopRequested = true; });
+    signal(SIGTERM, [](int) { s_stopRequested = true; });
+#endif
+}
+} // namespace
+
+struct LoadGenerator
+{
+    explicit LoadGenerator(const BotSettings& acSettings) noexcept
+        : m_settings(acSettings)
+    {
+        const uint32_t cBotCount = uBotCount.value_as<uint32_t>();
+
+        m_bots.reserve(cBotCount);
+        m_totals.resize(cBotCount);
+        for (uint32_t i = 0; i < cBotCount; ++i)
+            m_bots.push_back(MakeUnique<Bot>(i, m_settings));
+    }
+
+    TP_NOCOPYMOVE(LoadGenerator);
+
+    void Run() noexcept
+    {
+        using namespace std::chrono;
+
+        const auto cFrameTime = duration_cast<steady_clock::duration>(1s) / std::max(uUpdateRate.value_as<uint32_t>(), 1u);
+        const auto cConnectDelay = duration_cast<steady_clock::duration>(1s) / std::max(uConnectRate.value_as<uint32_t>(), 1u);
+        const auto cReportInterval = seconds(std::max(uReportInterval.value_as<uint32_t>(), 1u));
+        const auto cDuration = seconds(uDuration.value_as<uint32_t>());
+
+        const auto cStart = steady_clock::now();
+        auto nextFrame = cStart;
+        auto nextConnect = cStart;
+        auto lastReport = cStart;
+        std::optional<steady_clock::time_point> rampEnd;
+
+        m_totalStart = cStart;
+
+        while (!s_stopRequested)
+        {
+            const auto cNow = steady_clock::now();
+
+            if (m_started < m_bots.size() && cNow >= nextConnect)
+            {
+                if (!m_bots[m_started]->Start())
+                    spdlog::error("Bot {} failed to connect to {}", m_started, m_settings.Endpoint);
+
+                ++m_started;
+                nextConnect = cNow + cConnectDelay;
+
+                if (m_started == m_bots.size())
+                    rampEnd = cNow;
+            }
+
+            for (auto& pBot : m_bots)
+                pBot->Update(cNow);
+
+            UpdateParties();
+
+            if (cNow - lastReport >= cReportInterval)
+            {
+                Report(duration<double>(cNow - lastReport).count(), false);
+                lastReport = cNow;
+            }
+
+            if (rampEnd && cDuration.count() > 0 && cNow - *rampEnd >= cDuration)
+                break;
+
+            nextFrame += cFrameTime;
+            std::this_thread::sleep_until(nextFrame);
+        }
+
+        Report(duration<double>(steady_clock::now() - lastReport).count(), false);
+        Report(duration<double>(steady_clock::now() - m_totalStart).count(), true);
+
+        for (auto& pBot : m_bots)
+            pBot->Close();
+    }
+
+private:
+    // Hands the members of each group to its leader once they are all in world
+    void UpdateParties() noexcept
+    {
+        const uint32_t cPartySize = uPartySize.value_as<uint32_t>();
+        if (cPartySize < 2)
+            return;
+
+        for (size_t leader = 0; leader + 1 < m_bots.size(); leader += cPartySize)
+        {
+            if (m_bots[leader]->HasPartyMembers() || !m_bots[leader]->IsInWorld())
+                continue;
+
+            const size_t cEnd = std::min(leader + cPartySize, m_bots.size());
+
+            Vector<uint32_t> members;
+            for (size_t i = leader + 1; i < cEnd && m_bots[i]->IsInWorld(); ++i)
+                members.push_back(m_bots[i]->GetPlayerId());
+
+            if (members.size() + 1 == cEnd - leader)
+                m_bots[leader]->SetPartyMembers(std::move(members));
+        }
+    }
+
+    void Report(double aSeconds, bool aTotal) noexcept
+    {
+        if (aSeconds <= 0.0)
+            return;
+
+        uint32_t inWorld = 0;
+        uint64_t totalSent = 0;
+        uint64_t totalReceived = 0;
+        uint64_t maxReceived = 0;
+        uint64_t packetsReceived = 0;
+        uint64_t messagesReceived = 0;
+        Vector<uint32_t> chatLatencies;
+        Vector<uint32_t> snapshotIntervals;
+
+        for (size_t i = 0; i < m_bots.size(); ++i)
+        {
+            auto& statistics = aTotal ? m_totals[i] : m_bots[i]->GetStatistics();
+            if (!aTotal)
+                Accumulate(m_totals[i], statistics);
+
+            if (m_bots[i]->IsInWorld())
+                ++inWorld;
+
+            totalSent += statistics.BytesSent;
+            totalReceived += statistics.BytesReceived;
+            maxReceived = std::max(maxReceived, statistics.BytesReceived);
+            packetsReceived += statistics.PacketsReceived;
+            messagesReceived += statistics.MessagesReceived;
+            chatLatencies.insert(chatLatencies.end(), statistics.ChatLatencies.begin(), statistics.ChatLatencies.end());
+            snapshotIntervals.insert(snapshotIntervals.end(), statistics.SnapshotIntervals.begin(), statistics.SnapshotIntervals.end());
+
+            if (!aTotal)
+                statistics.Reset();
+        }
+
+        const double cClients = std::max<double>(inWorld, 1.0);
+        const double cSnapshotMean = snapshotIntervals.empty() ? 0.0 :
+            static_cast<double>(std::accumulate(snapshotIntervals.begin(), snapshotIntervals.end(), uint64_t{0})) / snapshotIntervals.size();
+
+        spdlog::info("{} {:.0f}s: {}/{} bots in world", aTotal ? "Total" : "Last", aSeconds, inWorld, m_bots.size());
+        spdlog::info("  per client: rx {:.1f} KiB/s (max {:.1f}), tx {:.1f} KiB/s",
+                     totalReceived / cClients / aSeconds / 1024.0, maxReceived / aSeconds / 1024.0,
+                     totalSent / cClients / aSeconds / 1024.0);
+        spdlog::info("  per client: rx {:.0f} packets/s carrying {:.0f} messages/s", packetsReceived / cClients / aSeconds,
+                     messagesReceived / cClients / aSeconds);
+        spdlog::info("  server tick (snapshot interval): mean {:.1f}ms, p50 {}ms, p99 {}ms", cSnapshotMean,
+                     Percentile(snapshotIntervals, 50), Percentile(snapshotIntervals, 99));
+        spdlog::info("  chat round trip: {} samples, p50 {:.2f}ms, p99 {:.2f}ms", chatLatencies.size(),
+                     Percentile(chatLatencies, 50) / 1000.0, Percentile(chatLatencies, 99) / 1000.0);
+    }
+
+    static void Accumulate(BotStatistics& aTotal, const BotStatistics& acWindow) noexcept
+    {
+        aTotal.BytesSent += acWindow.BytesSent;
+        aTotal.BytesReceived += acWindow.BytesReceived;
+        aTotal.MessagesSent += acWindow.MessagesSent;
+        aTotal.MessagesReceived += acWindow.MessagesReceived;
+        aTotal.PacketsReceived += acWindow.PacketsReceived;
+        aTotal.ChatLatencies.insert(aTotal.ChatLatencies.end(), acWindow.ChatLatencies.begin(), acWindow.ChatLatencies.end());
+        aTotal.SnapshotIntervals.insert(aTotal.SnapshotIntervals.end(), acWindow.SnapshotIntervals.begin(), acWindow.SnapshotIntervals.end());
+    }
+
+    const BotSettings& m_settings;
+    Vector<UniquePtr<Bot>> m_bots;
+    // Whole run statistics, index matches m_bots
+    Vector<BotStatistics> m_totals;
+    size_t m_started{0};
+    std::chrono::steady_clock::time_point m_totalStart{};
+};
+
+int main(int argc, char** argv)
+{
+    Base::SetCurrentThreadName("LoadGeneratorMain");
+
+    auto pLogger = spdlog::stdout_color_mt(kLoggerName);
+    pLogger->set_pattern("%^[%H:%M:%S] [%l]%$ %v");
+    spdlog::set_default_logger(pLogger);
+
+    Console::ConsoleRegistry registry(kLoggerName);
+    Console::LoadSettingsFromCommand(registry, argc, argv);
+
+    const auto cPattern = MovementPattern::Parse(sPattern.c_str());
+    if (!cPattern)
+    {
+        spdlog::error("Unknown movement pattern '{}', expected idle, circle, wander or patrol", sPattern.c_str());
+        return 1;
+    }
+
+    BotSettings settings{};
+    settings.Endpoint = sEndpoint.c_str();
+    settings.Password = sPassword.c_str();
+    settings.Pattern = *cPattern;
+    settings.Origin = {fOriginX.value_as<float>(), fOriginY.value_as<float>(), fOriginZ.value_as<float>()};
+    settings.SpawnSpread = fSpawnSpread.value_as<float>();
+    settings.Radius = fRadius.value_as<float>();
+    settings.Speed = fSpeed.value_as<float>();
+    settings.WorldSpaceId = GameId{0, uWorldSpaceId.value_as<uint32_t>()};
+    settings.CellId = GameId{0, uCellId.value_as<uint32_t>()};
+    settings.MoveInterval = std::chrono::milliseconds(std::max(uMoveInterval.value_as<uint32_t>(), 1u));
+    settings.ChatInterval = std::chrono::milliseconds(uChatInterval.value_as<uint32_t>());
+
+    RegisterQuitHandler();
+
+    spdlog::info("Starting {} bots against {} ({} pattern)", uBotCount.value_as<uint32_t>(), settings.Endpoint, sPattern.c_str());
+
+    LoadGenerator generator(settings);
+    generator.Run();
+
+    return 0;
+}
@@ -0,0 +1,26 @@
+
+target("LoadGenerator")
+    set_basename("TPLoadGenerator")
+    set_kind("binary")
+    set_group("Tests")
+    add_defines("TP_SKYRIM=1")
+    add_includedirs(
+        ".",
+        "../",
+        "../encoding")
+    add_headerfiles("**.h")
+    add_files("**.cpp")
+    add_deps(
+        "SkyrimEncoding",
+        "CommonLib",
+        "Console",
+        "BaseLib",
+        "TiltedConnect")
+    add_packages(
+        "tiltedcore",
+        "spdlog",
+        "hopscotch-map",
+        "glm",
+        "gamenetworkingsockets",
+        "sentry-native")
+    add_defines("SPDLOG_HEADER_ONLY")
@@ -15,5 +15,6 @@
 #include <Components/PartyComponent.h>
 #include <Components/ActorValuesComponent.h>
 #include <Components/ObjectComponent.h>
+#include <Components/DirtyComponents.h>
 
 #undef TP_INTERNAL_COMPONENTS_GUARD
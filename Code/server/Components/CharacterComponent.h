@@ -11,7 +11,7 @@ struct CharacterComponent
 {
     enum
     {
-        kIsDirtyFactions = 1 << 0,
+        // 1 << 0 is free, dirty factions are tracked with FactionsDirtyComponent
         kIsDead = 1 << 1,
         kIsPlayer = 1 << 2,
         kIsWeaponDrawn = 1 << 3,
@@ -20,10 +20,6 @@ struct CharacterComponent
         kIsPlayerSummon = 1 <<6
     };
 
-    [[nodiscard]] bool IsDirtyFactions() const
-    {
-        return Flags & kIsDirtyFactions;
-    }
     [[nodiscard]] bool IsDead() const
     {
         return Flags & kIsDead;
@@ -49,13 +45,6 @@ struct CharacterComponent
         return Flags & kIsPlayerSummon;
     }
 
-    void SetDirtyFactions(bool aSet)
-    {
-        if (aSet)
-            Flags |= kIsDirtyFactions;
-        else
-            Flags &= ~kIsDirtyFactions;
-    }
     void SetDead(bool aSet)
     {
         if (aSet)
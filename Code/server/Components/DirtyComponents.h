@@ -0,0 +1,15 @@
+#pragma once
+
+#ifndef TP_INTERNAL_COMPONENTS_GUARD
+#error Include Components.h instead
+#endif
+
+// Tags on the characters CharacterService has to replicate in its next snapshot, the snapshot only visits
+// the tagged characters and removes the tags once sent.
+struct MovementDirtyComponent
+{
+};
+
+struct FactionsDirtyComponent
+{
+};
@@ -46,3 +46,33 @@ bool ModsComponent::IsInstalled(const String& acpFilename) const noexcept
 
     return it != m_serverMods.end();
 }
+
+uint32_t ModsComponent::GetServerFormId(const GameId& acId) const noexcept
+{
+    // Game ids carry the session mod id handed out above, the record collection uses the server's load order
+    for (const auto& [filename, entry] : m_standardMods)
+    {
+        if (entry.id != acId.ModId)
+            continue;
+
+        const auto itor = m_serverMods.find(filename);
+        if (itor == std::end(m_serverMods))
+            return 0;
+
+        return ((itor->second.id & 0xFF) << 24) | (acId.BaseId & 0x00FFFFFF);
+    }
+
+    for (const auto& [filename, entry] : m_liteMods)
+    {
+        if (entry.id != acId.ModId)
+            continue;
+
+        const auto itor = m_serverMods.find(filename);
+        if (itor == std::end(m_serverMods))
+            return 0;
+
+        return 0xFE000000 | ((itor->second.id & 0xFFF) << 12) | (acId.BaseId & 0xFFF);
+    }
+
+    return 0;
+}
@@ -9,6 +9,8 @@ namespace ESLoader
 struct PluginData;
 }
 
+struct GameId;
+
 struct ModsComponent
 {
     struct Entry
@@ -37,6 +39,9 @@ struct ModsComponent
 
     bool IsInstalled(const String& acpFileName) const noexcept;
 
+    // Form id of a client game id in the server's record collection, 0 if the mod isn't loaded by the server
+    [[nodiscard]] uint32_t GetServerFormId(const GameId& acId) const noexcept;
+
     using TModList = TiltedPhoques::Map<String, Entry>; 
 
 private:
@@ -0,0 +1,11 @@
+#pragma once
+
+/**
+* @brief Dispatched on the game thread when the server list answered an announcement.
+*/
+struct AnnouncementResultEvent
+{
+    // HTTP status, 0 if the server list could not be reached
+    int Status{0};
+    String Error{};
+};
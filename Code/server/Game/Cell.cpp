@@ -1,2 +1,18 @@
 #include "Cell.h"
 
+void Cell::Add(Player* apPlayer) noexcept
+{
+    if (std::find(std::begin(m_players), std::end(m_players), apPlayer) == std::end(m_players))
+        m_players.push_back(apPlayer);
+}
+
+void Cell::Remove(Player* apPlayer) noexcept
+{
+    const auto itor = std::find(std::begin(m_players), std::end(m_players), apPlayer);
+    if (itor == std::end(m_players))
+        return;
+
+    // Order doesn't matter, swap with the last one to avoid shifting
+    *itor = m_players.back();
+    m_players.pop_back();
+}
@@ -1,6 +1,22 @@
 #pragma once
 
+struct Player;
+
+/**
+* @brief Bucket of the players currently located in a cell.
+*/
 struct Cell
 {
-    
+    Cell() noexcept = default;
+    ~Cell() noexcept = default;
+
+    void Add(Player* apPlayer) noexcept;
+    void Remove(Player* apPlayer) noexcept;
+
+    [[nodiscard]] bool IsEmpty() const noexcept { return m_players.empty(); }
+    [[nodiscard]] const Vector<Player*>& GetPlayers() const noexcept { return m_players; }
+
+private:
+
+    Vector<Player*> m_players;
 };
@@ -1 +1,62 @@
 #include "Map.h"
+
+void WorldMap::Add(Player* apPlayer, const CellIdComponent& acCell) noexcept
+{
+    // Players that haven't loaded a cell yet can't be in range of anything
+    if (!acCell)
+        return;
+
+    m_cells[acCell.Cell].Add(apPlayer);
+
+    if (acCell.IsInInteriorCell())
+        return;
+
+    auto itor = m_regions.find(acCell.WorldSpaceId);
+    if (itor == std::end(m_regions))
+        itor = m_regions.emplace(acCell.WorldSpaceId, Region(GetWorldSpaceBounds(acCell.WorldSpaceId))).first;
+
+    itor.value().Add(acCell.CenterCoords, apPlayer);
+}
+
+void WorldMap::Remove(Player* apPlayer, const CellIdComponent& acCell) noexcept
+{
+    if (!acCell)
+        return;
+
+    if (const auto itor = m_cells.find(acCell.Cell); itor != std::end(m_cells))
+    {
+        itor.value().Remove(apPlayer);
+        if (itor->second.IsEmpty())
+            m_cells.erase(itor);
+    }
+
+    if (acCell.IsInInteriorCell())
+        return;
+
+    if (const auto itor = m_regions.find(acCell.WorldSpaceId); itor != std::end(m_regions))
+    {
+        itor.value().Remove(acCell.CenterCoords, apPlayer);
+        if (itor->second.IsEmpty() && !itor->second.IsBounded())
+            m_regions.erase(itor);
+    }
+}
+
+void WorldMap::Move(Player* apPlayer, const CellIdComponent& acOldCell, const CellIdComponent& acNewCell) noexcept
+{
+    Remove(apPlayer, acOldCell);
+    Add(apPlayer, acNewCell);
+}
+
+std::optional<GridBounds> WorldMap::GetWorldSpaceBounds(const GameId& acWorldSpaceId) const noexcept
+{
+    // Only called when a region is first built, regions with bounds are kept afterwards
+    if (m_worldSpaceBounds.empty() || !m_resolver)
+        return std::nullopt;
+
+    const uint32_t cFormId = m_resolver(acWorldSpaceId);
+    const auto itor = m_worldSpaceBounds.find(cFormId);
+    if (itor == std::end(m_worldSpaceBounds))
+        return std::nullopt;
+
+    return itor->second;
+}
@@ -1 +1,62 @@
 #pragma once
+
+#include "Region.h"
+
+/**
+* @brief Spatial index of the players, by cell and by exterior grid cell.
+*
+* Kept up to date by the player manager so range queries only visit nearby players.
+*/
+struct WorldMap
+{
+    WorldMap() noexcept = default;
+    ~WorldMap() noexcept = default;
+
+    TP_NOCOPYMOVE(WorldMap);
+
+    void Add(Player* apPlayer, const CellIdComponent& acCell) noexcept;
+    void Remove(Player* apPlayer, const CellIdComponent& acCell) noexcept;
+    void Move(Player* apPlayer, const CellIdComponent& acOldCell, const CellIdComponent& acNewCell) noexcept;
+
+    // Maps a worldspace id to its form id in the server's load order, 0 if the server doesn't know it
+    using FormIdResolver = std::function<uint32_t(const GameId&)>;
+
+    // Grid bounds of the worldspaces by server form id, regions built afterwards use them
+    void SetWorldSpaceBounds(Map<uint32_t, GridBounds> aBounds, FormIdResolver aResolver) noexcept
+    {
+        m_worldSpaceBounds = std::move(aBounds);
+        m_resolver = std::move(aResolver);
+    }
+
+    // Calls the functor for each player for which acOrigin.IsInRange(player cell, aIsDragon) holds
+    template<class T>
+    void ForEachPlayerInRange(const CellIdComponent& acOrigin, bool aIsDragon, const T& acFunctor) const noexcept
+    {
+        if (acOrigin.IsInInteriorCell())
+        {
+            const auto itor = m_cells.find(acOrigin.Cell);
+            if (itor == std::end(m_cells))
+                return;
+
+            for (Player* pPlayer : itor->second.GetPlayers())
+                acFunctor(pPlayer);
+
+            return;
+        }
+
+        const auto itor = m_regions.find(acOrigin.WorldSpaceId);
+        if (itor == std::end(m_regions))
+            return;
+
+        itor->second.ForEachPlayerInRange(acOrigin.CenterCoords, GridCellCoords::GetGridRadius(aIsDragon), acFunctor);
+    }
+
+private:
+
+    std::optional<GridBounds> GetWorldSpaceBounds(const GameId& acWorldSpaceId) const noexcept;
+
+    Map<uint32_t, GridBounds> m_worldSpaceBounds;
+    FormIdResolver m_resolver;
+    Map<GameId, Cell> m_cells;
+    Map<GameId, Region> m_regions;
+};
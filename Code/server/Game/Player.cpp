@@ -26,6 +26,8 @@ Player::Player(Player&& aRhs) noexcept
     , m_party{std::exchange(aRhs.m_party, {})}
     , m_questLog{std::exchange(aRhs.m_questLog, {})}
     , m_cell{std::exchange(aRhs.m_cell, {})}
+    , m_movementBaselines{std::exchange(aRhs.m_movementBaselines, {})}
+    , m_pendingMovements{std::exchange(aRhs.m_pendingMovements, {})}
 {
 }
 
@@ -91,9 +93,16 @@ void Player::SetLevel(uint16_t aLevel) noexcept
 
 void Player::SetCellComponent(const CellIdComponent& aCellComponent) noexcept
 {
+    GameServer::Get()->GetWorld().GetPlayerManager().GetWorldMap().Move(this, m_cell, aCellComponent);
     m_cell = aCellComponent;
 }
 
+void Player::ForgetCharacter(uint32_t aServerId) noexcept
+{
+    m_movementBaselines.erase(aServerId);
+    m_pendingMovements.erase(aServerId);
+}
+
 void Player::Send(const ServerMessage& acServerMessage) const
 {
     GameServer::Get()->Send(GetConnectionId(), acServerMessage);
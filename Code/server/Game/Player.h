@@ -1,5 +1,7 @@
 #pragma once
 
+#include <Structs/Movement.h>
+
 struct ServerMessage;
 struct Player
 {
@@ -24,7 +26,13 @@ struct Player
     [[nodiscard]] const CellIdComponent& GetCellComponent() const noexcept;
     [[nodiscard]] QuestLogComponent& GetQuestLogComponent() noexcept;
     [[nodiscard]] const QuestLogComponent& GetQuestLogComponent() const noexcept;
-    
+    // Last movement sent to this player for each character, what the next movement snapshot is diffed against
+    [[nodiscard]] Map<uint32_t, Movement>& GetMovementBaselines() noexcept { return m_movementBaselines; }
+    // Characters whose latest movement was held back and still has to be sent, with the priority built up while waiting
+    [[nodiscard]] Map<uint32_t, float>& GetPendingMovements() noexcept { return m_pendingMovements; }
+    // Drops the replication state of a character, it is sent whole the next time it comes in range
+    void ForgetCharacter(uint32_t aServerId) noexcept;
+
 
     void SetDiscordId(uint64_t aDiscordId) noexcept;
     void SetEndpoint(String aEndpoint) noexcept;
@@ -53,6 +61,8 @@ private:
     PartyComponent m_party;
     QuestLogComponent m_questLog;
     CellIdComponent m_cell;
+    Map<uint32_t, Movement> m_movementBaselines;
+    Map<uint32_t, float> m_pendingMovements;
     uint32_t m_stringCacheId{0};
     uint16_t m_level{0};
 };
@@ -23,6 +23,7 @@ Player* PlayerManager::Create(ConnectionId_t aConnectionId) noexcept
 
 void PlayerManager::Remove(Player* apPlayer) noexcept
 {
+    m_worldMap.Remove(apPlayer, apPlayer->GetCellComponent());
     m_players.erase(apPlayer->GetConnectionId());
 }
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Map.h"
+
 struct Player;
 
 struct PlayerManager
@@ -36,6 +38,9 @@ struct PlayerManager
 
     uint32_t Count() const noexcept;
 
+    WorldMap& GetWorldMap() noexcept { return m_worldMap; }
+    const WorldMap& GetWorldMap() const noexcept { return m_worldMap; }
+
     template<class T>
     void ForEach(const T& acFunctor) noexcept
     {
@@ -50,4 +55,5 @@ struct PlayerManager
 private:
 
     TMap m_players;
+    WorldMap m_worldMap;
 };
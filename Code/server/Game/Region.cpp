@@ -1 +1,81 @@
 #include "Region.h"
+
+Region::Region(const std::optional<GridBounds>& acBounds) noexcept
+{
+    if (!acBounds || acBounds->MinX > acBounds->MaxX || acBounds->MinY > acBounds->MaxY)
+        return;
+
+    const size_t cWidth = acBounds->GetWidth();
+    const size_t cHeight = acBounds->GetHeight();
+    if (cWidth * cHeight > kMaxBoundedCells)
+        return;
+
+    m_bounds = *acBounds;
+    m_wordsPerRow = (cWidth + 63) / 64;
+    m_boundedCells.resize(cWidth * cHeight);
+    m_occupancy.resize(m_wordsPerRow * cHeight, 0);
+}
+
+void Region::Add(const GridCellCoords& acCoords, Player* apPlayer) noexcept
+{
+    size_t index = 0;
+    if (Cell* pCell = GetBoundedCell(acCoords, index))
+    {
+        pCell->Add(apPlayer);
+        SetOccupied(index, true);
+        return;
+    }
+
+    m_cells[glm::ivec2(acCoords.X, acCoords.Y)].Add(apPlayer);
+}
+
+void Region::Remove(const GridCellCoords& acCoords, Player* apPlayer) noexcept
+{
+    size_t index = 0;
+    if (Cell* pCell = GetBoundedCell(acCoords, index))
+    {
+        pCell->Remove(apPlayer);
+        SetOccupied(index, !pCell->IsEmpty());
+        return;
+    }
+
+    const auto itor = m_cells.find(glm::ivec2(acCoords.X, acCoords.Y));
+    if (itor == std::end(m_cells))
+        return;
+
+    itor.value().Remove(apPlayer);
+
+    if (itor->second.IsEmpty())
+        m_cells.erase(itor);
+}
+
+Cell* Region::GetBoundedCell(const GridCellCoords& acCoords, size_t& aIndex) noexcept
+{
+    if (!IsBounded() || !m_bounds.Contains(acCoords.X, acCoords.Y))
+        return nullptr;
+
+    const size_t cRow = static_cast<size_t>(int64_t(acCoords.Y) - m_bounds.MinY);
+    const size_t cColumn = static_cast<size_t>(int64_t(acCoords.X) - m_bounds.MinX);
+
+    aIndex = cRow * m_bounds.GetWidth() + cColumn;
+    return &m_boundedCells[aIndex];
+}
+
+void Region::SetOccupied(size_t aIndex, bool aOccupied) noexcept
+{
+    const size_t cWidth = m_bounds.GetWidth();
+    const size_t cRow = aIndex / cWidth;
+    const size_t cColumn = aIndex % cWidth;
+
+    uint64_t& word = m_occupancy[cRow * m_wordsPerRow + cColumn / 64];
+    const uint64_t cMask = 1ull << (cColumn % 64);
+
+    if (aOccupied == ((word & cMask) != 0))
+        return;
+
+    word ^= cMask;
+    if (aOccupied)
+        ++m_occupiedCount;
+    else
+        --m_occupiedCount;
+}
@@ -1,12 +1,151 @@
 #pragma once
 
-struct Cell;
+#include "Cell.h"
 
+#include <bit>
+#include <limits>
+
+/**
+* @brief Inclusive range of exterior grid cells a worldspace spans.
+*/
+struct GridBounds
+{
+    [[nodiscard]] bool Contains(int32_t aX, int32_t aY) const noexcept
+    {
+        return aX >= MinX && aX <= MaxX && aY >= MinY && aY <= MaxY;
+    }
+
+    [[nodiscard]] size_t GetWidth() const noexcept { return static_cast<size_t>(MaxX - MinX + 1); }
+    [[nodiscard]] size_t GetHeight() const noexcept { return static_cast<size_t>(MaxY - MinY + 1); }
+
+    int32_t MinX{0};
+    int32_t MinY{0};
+    int32_t MaxX{0};
+    int32_t MaxY{0};
+};
+
+/**
+* @brief Exterior grid cells of a worldspace and the players standing in them.
+*
+* When the worldspace bounds are known, the cells inside them live in a flat array with an occupancy bitset per
+* row, a range query then only walks the set bits of the window. Cells outside the bounds, or all of them when
+* the bounds are unknown, fall back to a map.
+*/
 struct Region
 {
+    // Above this many cells the bounds are ignored, the arrays would cost more than they save
+    static constexpr size_t kMaxBoundedCells = 1 << 16;
+
+    explicit Region(const std::optional<GridBounds>& acBounds = std::nullopt) noexcept;
+
+    void Add(const GridCellCoords& acCoords, Player* apPlayer) noexcept;
+    void Remove(const GridCellCoords& acCoords, Player* apPlayer) noexcept;
+
+    [[nodiscard]] bool IsEmpty() const noexcept { return m_occupiedCount == 0 && m_cells.empty(); }
+    // Bounded regions are worth keeping around once built, even when empty
+    [[nodiscard]] bool IsBounded() const noexcept { return !m_boundedCells.empty(); }
+
+    // Calls the functor for each player whose grid is centered at most aRadius cells away from acCenter
+    template<class T>
+    void ForEachPlayerInRange(const GridCellCoords& acCenter, int32_t aRadius, const T& acFunctor) const noexcept
+    {
+        if (m_occupiedCount > 0)
+            ForEachBoundedPlayerInRange(acCenter, aRadius, acFunctor);
+
+        if (m_cells.empty())
+            return;
+
+        // 64 bit math, the center comes straight from the client and is INT_MAX for players without a cell
+        const int64_t cMinX = std::max<int64_t>(int64_t(acCenter.X) - aRadius, std::numeric_limits<int32_t>::min());
+        const int64_t cMaxX = std::min<int64_t>(int64_t(acCenter.X) + aRadius, std::numeric_limits<int32_t>::max());
+        const int64_t cMinY = std::max<int64_t>(int64_t(acCenter.Y) - aRadius, std::numeric_limits<int32_t>::min());
+        const int64_t cMaxY = std::min<int64_t>(int64_t(acCenter.Y) + aRadius, std::numeric_limits<int32_t>::max());
+
+        if (cMinX > cMaxX || cMinY > cMaxY)
+            return;
+
+        // Sparse regions are cheaper to scan than to probe every grid cell of the window
+        if (static_cast<uint64_t>(m_cells.size()) < static_cast<uint64_t>(cMaxX - cMinX + 1) * static_cast<uint64_t>(cMaxY - cMinY + 1))
+        {
+            for (const auto& [coords, cell] : m_cells)
+            {
+                if (coords.x < cMinX || coords.x > cMaxX || coords.y < cMinY || coords.y > cMaxY)
+                    continue;
 
+                for (Player* pPlayer : cell.GetPlayers())
+                    acFunctor(pPlayer);
+            }
+
+            return;
+        }
+
+        for (int64_t x = cMinX; x <= cMaxX; ++x)
+        {
+            for (int64_t y = cMinY; y <= cMaxY; ++y)
+            {
+                const auto itor = m_cells.find(glm::ivec2(static_cast<int32_t>(x), static_cast<int32_t>(y)));
+                if (itor == std::end(m_cells))
+                    continue;
+
+                for (Player* pPlayer : itor->second.GetPlayers())
+                    acFunctor(pPlayer);
+            }
+        }
+    }
 
 private:
 
-    //Map<glm::ivec2, Cell> m_cells;
+    template<class T>
+    void ForEachBoundedPlayerInRange(const GridCellCoords& acCenter, int32_t aRadius, const T& acFunctor) const noexcept
+    {
+        // Clip the window to the bounds, 64 bit math as the center comes straight from the client
+        const int64_t cMinX = std::max<int64_t>(int64_t(acCenter.X) - aRadius, m_bounds.MinX);
+        const int64_t cMaxX = std::min<int64_t>(int64_t(acCenter.X) + aRadius, m_bounds.MaxX);
+        const int64_t cMinY = std::max<int64_t>(int64_t(acCenter.Y) - aRadius, m_bounds.MinY);
+        const int64_t cMaxY = std::min<int64_t>(int64_t(acCenter.Y) + aRadius, m_bounds.MaxY);
+
+        if (cMinX > cMaxX || cMinY > cMaxY)
+            return;
+
+        const size_t cFirstColumn = static_cast<size_t>(cMinX - m_bounds.MinX);
+        const size_t cLastColumn = static_cast<size_t>(cMaxX - m_bounds.MinX);
+        const size_t cWidth = m_bounds.GetWidth();
+
+        for (size_t row = static_cast<size_t>(cMinY - m_bounds.MinY); row <= static_cast<size_t>(cMaxY - m_bounds.MinY); ++row)
+        {
+            const uint64_t* pWords = m_occupancy.data() + row * m_wordsPerRow;
+
+            for (size_t word = cFirstColumn / 64; word <= cLastColumn / 64; ++word)
+            {
+                uint64_t bits = pWords[word];
+
+                // Mask out the columns on either side of the window
+                if (word == cFirstColumn / 64)
+                    bits &= ~0ull << (cFirstColumn % 64);
+                if (word == cLastColumn / 64)
+                    bits &= ~0ull >> (63 - cLastColumn % 64);
+
+                while (bits)
+                {
+                    const size_t column = word * 64 + static_cast<size_t>(std::countr_zero(bits));
+                    bits &= bits - 1;
+
+                    for (Player* pPlayer : m_boundedCells[row * cWidth + column].GetPlayers())
+                        acFunctor(pPlayer);
+                }
+            }
+        }
+    }
+
+    Cell* GetBoundedCell(const GridCellCoords& acCoords, size_t& aIndex) noexcept;
+    void SetOccupied(size_t aIndex, bool aOccupied) noexcept;
+
+    GridBounds m_bounds{};
+    size_t m_wordsPerRow{0};
+    size_t m_occupiedCount{0};
+    // Row major, one row per Y
+    Vector<Cell> m_boundedCells;
+    Vector<uint64_t> m_occupancy;
+
+    Map<glm::ivec2, Cell> m_cells;
 };
@@ -10,6 +10,10 @@
 #include <Events/PlayerLeaveCellEvent.h>
 #include <Events/PlayerLeaveEvent.h>
 #include <Events/UpdateEvent.h>
+#include <Network/NetworkQueues.h>
+#include <Network/SendBuffer.h>
+#include <Network/SerializedMessage.h>
+#include <Profiling/TickProfiler.h>
 #include <steam/isteamnetworkingutils.h>
 
 #include <AdminMessages/AdminSessionOpen.h>
@@ -19,6 +23,7 @@
 #include <Messages/NotifyPlayerLeft.h>
 #include <Messages/NotifyPlayerJoined.h>
 #include <Messages/NotifySettingsChange.h>
+#include <base/threading/ThreadUtils.h>
 #include <console/ConsoleRegistry.h>
 
 constexpr size_t kMaxServerNameLength = 128u;
@@ -27,6 +32,9 @@ constexpr size_t kMaxServerNameLength = 128u;
 Console::Setting uServerPort{"GameServer:uPort", "Which port to host the server on", 10578u};
 Console::Setting uMaxPlayerCount{"GameServer:uMaxPlayerCount", "Maximum number of players allowed on the server (going over the default of 8 is not recommended)", 8u};
 Console::Setting bPremiumTickrate{"GameServer:bPremiumMode", "Use premium tick rate", true};
+Console::Setting uProfilerDumpInterval{"GameServer:uProfilerDumpInterval", "Seconds between tick profiler dumps in the log (0 to disable)", 0u};
+Console::Setting bNetworkThread{"GameServer:bNetworkThread", "Poll the sockets and decode packets on a dedicated thread", false};
+Console::Setting bBundleMessages{"GameServer:bBundleMessages", "Pack the messages sent to a client during a tick into shared packets", true};
 
 Console::StringSetting sServerName{"GameServer:sServerName", "Name that shows up in the server list",
                                    "Dedicated Together Server"};
@@ -53,6 +61,8 @@ Console::Setting bAllowMO2{"ModPolicy:bAllowMO2", "Allow clients running Mod Org
 Console::Command<> TogglePremium("TogglePremium", "Toggle Premium Tickrate on/off", [](Console::ArgStack&) {
     bPremiumTickrate = !bPremiumTickrate;
     spdlog::get("ConOut")->info("Premium Tickrate has been {}.", bPremiumTickrate == true ? "enabled" : "disabled");
+    // The runner paces the ticks with the rate from the info, refresh it so the change applies right away
+    GameServer::Get()->UpdateInfo();
 });
 
 Console::Command<> TogglePvp("TogglePvp", "Toggle PvP on/off", [](Console::ArgStack&){
@@ -94,6 +104,36 @@ Console::Command<> ShowMoPoStatus("ShowMOPOStats", "Shows the status of ModPolic
                                 formatStatus(bEnableModCheck), formatStatus(bAllowSKSE), formatStatus(bAllowMO2));
 });
 
+Console::Command<> ShowSendStats("ShowSendStats", "Shows serialized size statistics per outgoing opcode", [](Console::ArgStack&) {
+    auto out = spdlog::get("ConOut");
+
+    for (uint32_t opcode = 0; opcode < kServerOpcodeMax; ++opcode)
+    {
+        const auto& statistics = SendBuffer::GetStatistics(static_cast<ServerOpcode>(opcode));
+
+        const uint64_t count = statistics.Count;
+        if (count == 0)
+            continue;
+
+        out->info("Opcode {}: {} sent, {} bytes average, {} bytes peak", opcode, count, statistics.TotalBytes / count,
+                  statistics.PeakBytes.load());
+    }
+});
+
+Console::Command<> ShowTickProfile("ShowTickProfile", "Shows wall time per service update, inbound and outbound opcode", [](Console::ArgStack&) {
+    TickProfiler::Get().Dump(*spdlog::get("ConOut"));
+});
+
+Console::Command<> ResetTickProfile("ResetTickProfile", "Resets the tick profiler timings", [](Console::ArgStack&) {
+    TickProfiler::Get().Reset();
+    spdlog::get("ConOut")->info("Tick profiler has been reset.");
+});
+
+Console::Command<> ResetSendStats("ResetSendStats", "Resets the outgoing opcode size statistics", [](Console::ArgStack&) {
+    SendBuffer::ResetStatistics();
+    spdlog::get("ConOut")->info("Send statistics have been reset.");
+});
+
 // -- Constants --
 constexpr char kBypassMoPoWarning[]{
     "ModCheck is disabled. This can lead to desync and other oddities. Make sure you know what you are doing. We "
@@ -169,6 +209,8 @@ GameServer::GameServer(Console::ConsoleRegistry& aConsole) noexcept
 
 GameServer::~GameServer()
 {
+    StopNetworkThread();
+
     s_pInstance = nullptr;
 }
 
@@ -183,6 +225,22 @@ void GameServer::Initialize()
         return;
 
     BindServerCommands();
+
+    if (bNetworkThread)
+        StartNetworkThread();
+}
+
+void GameServer::Tick()
+{
+    if (!m_pNetworkQueues)
+    {
+        // Polls the sockets, then calls OnUpdate
+        Update();
+        return;
+    }
+
+    ProcessInbound();
+    Simulate();
 }
 
 void GameServer::Kill()
@@ -212,36 +270,7 @@ bool GameServer::CheckMoPo()
 
 void GameServer::BindMessageHandlers()
 {
-    auto handlerGenerator = [this](auto& x) {
-        using T = typename std::remove_reference_t<decltype(x)>::Type;
-
-        m_messageHandlers[T::Opcode] = [this](UniquePtr<ClientMessage>& apMessage, ConnectionId_t aConnectionId) {
-            auto* pPlayer = m_pWorld->GetPlayerManager().GetByConnectionId(aConnectionId);
-
-            if (!pPlayer)
-            {
-                spdlog::error("Connection {:x} is not associated with a player.", aConnectionId);
-                Kick(aConnectionId);
-                return;
-            }
-
-            const auto pRealMessage = CastUnique<T>(std::move(apMessage));
-
-            m_pWorld->GetDispatcher().trigger(PacketEvent<T>(pRealMessage.get(), pPlayer));
-        };
-
-        return false;
-    };
-
-    ClientMessageFactory::Visit(handlerGenerator);
-
-    // Override authentication request
-    m_messageHandlers[AuthenticationRequest::Opcode] = [this](UniquePtr<ClientMessage>& apMessage,
-                                                              ConnectionId_t aConnectionId) {
-        const auto pRealMessage = CastUnique<AuthenticationRequest>(std::move(apMessage));
-        HandleAuthenticationRequest(aConnectionId, pRealMessage);
-    };
-
+    // Client messages are dispatched straight from the decoder, see OnConsume
     auto adminHandlerGenerator = [this](auto& x) {
         using T = typename std::remove_reference_t<decltype(x)>::Type;
 
@@ -348,7 +377,38 @@ void GameServer::UpdateTimeScale()
     }
 }
 
+template <class T> void GameServer::Dispatch(T& aMessage, const ConnectionId_t aConnectionId) noexcept
+{
+    TickProfiler::Scope profile(TickProfiler::Get().GetInbound(T::Opcode));
+
+    if constexpr (std::is_same_v<T, AuthenticationRequest>)
+    {
+        HandleAuthenticationRequest(aConnectionId, aMessage);
+    }
+    else
+    {
+        auto* pPlayer = m_pWorld->GetPlayerManager().GetByConnectionId(aConnectionId);
+        if (!pPlayer)
+        {
+            spdlog::error("Connection {:x} is not associated with a player.", aConnectionId);
+            Kick(aConnectionId);
+            return;
+        }
+
+        m_pWorld->GetDispatcher().trigger(PacketEvent<T>(&aMessage, pPlayer));
+    }
+}
+
 void GameServer::OnUpdate()
+{
+    // With a network thread this is called on it, the game thread simulates from Tick
+    if (m_pNetworkQueues)
+        return;
+
+    Simulate();
+}
+
+void GameServer::Simulate()
 {
     const auto cNow = std::chrono::high_resolution_clock::now();
     const auto cDelta = cNow - m_lastFrameTime;
@@ -358,10 +418,42 @@ void GameServer::OnUpdate()
 
     auto& dispatcher = m_pWorld->GetDispatcher();
 
-    dispatcher.trigger(UpdateEvent{cDeltaSeconds});
+    // Apply the state updates received this tick before the services look at them
+    m_inboundBatcher.FlushAll([this](auto& aMessage, ConnectionId_t aConnectionId) { Dispatch(aMessage, aConnectionId); });
+
+    {
+        TickProfiler::Scope profile(TickProfiler::Get().GetTick());
+        dispatcher.trigger(UpdateEvent{cDeltaSeconds});
+    }
+
+    TickProfiler::Get().Update(uProfilerDumpInterval.value_as<uint32_t>());
+
+    // Everything sent this tick, from the message handlers and the services, leaves together
+    m_outboundBundler.FlushAll([this](ConnectionId_t aConnectionId, char* apData, size_t aSize) { SendPacket(aConnectionId, apData, aSize); });
+
+    // Commands that didn't fit in the outbound queue shouldn't wait for the next send to leave
+    if (m_pNetworkQueues)
+        m_pNetworkQueues->FlushOutboundOverflow();
 
     if (m_requestStop)
+    {
+        StopNetworkThread();
         Close();
+    }
+}
+
+template <class T> void GameServer::HandleMessage(T& aMessage, const ConnectionId_t aConnectionId) noexcept
+{
+    if constexpr (InboundBatcher::IsBatched<T>)
+    {
+        m_inboundBatcher.Merge(aConnectionId, aMessage);
+    }
+    else
+    {
+        // Anything the connection sent before this message has to be applied first
+        m_inboundBatcher.Flush(aConnectionId, [this, aConnectionId](auto& aBatched) { Dispatch(aBatched, aConnectionId); });
+        Dispatch(aMessage, aConnectionId);
+    }
 }
 
 void GameServer::OnConsume(const void* apData, const uint32_t aSize, const ConnectionId_t aConnectionId)
@@ -369,6 +461,12 @@ void GameServer::OnConsume(const void* apData, const uint32_t aSize, const Conne
     ViewBuffer buf((uint8_t*)apData, aSize);
     Buffer::Reader reader(&buf);
 
+    if (m_pNetworkQueues)
+    {
+        QueueMessage(reader, aConnectionId);
+        return;
+    }
+
     if (m_adminSessions.contains(aConnectionId)) [[unlikely]]
     {
         const ClientAdminMessageFactory factory;
@@ -383,27 +481,57 @@ void GameServer::OnConsume(const void* apData, const uint32_t aSize, const Conne
     }
     else
     {
-        const ClientMessageFactory factory;
-        auto pMessage = factory.Extract(reader);
-        if (!pMessage)
-        {
-            spdlog::error("Couldn't parse packet from {:x}", aConnectionId);
-            return;
-        }
+        const bool cDecoded = ClientMessageFactory::Decode(
+            reader, [this, aConnectionId](auto& aMessage) { HandleMessage(aMessage, aConnectionId); });
 
-        m_messageHandlers[pMessage->GetOpcode()](pMessage, aConnectionId);
+        if (!cDecoded)
+            spdlog::error("Couldn't parse packet from {:x}", aConnectionId);
     }
 }
 
 void GameServer::OnConnection(const ConnectionId_t aHandle)
+{
+    if (m_pNetworkQueues)
+    {
+        PushInbound([aHandle](InboundNetworkEvent& aEvent) {
+            aEvent.Kind = InboundNetworkEvent::Type::kConnection;
+            aEvent.ConnectionId = aHandle;
+        });
+        return;
+    }
+
+    HandleConnection(aHandle);
+}
+
+void GameServer::OnDisconnection(const ConnectionId_t aConnectionId, EDisconnectReason aReason)
+{
+    if (m_pNetworkQueues)
+    {
+        m_networkAdminSessions.erase(aConnectionId);
+
+        PushInbound([aConnectionId, aReason](InboundNetworkEvent& aEvent) {
+            aEvent.Kind = InboundNetworkEvent::Type::kDisconnection;
+            aEvent.ConnectionId = aConnectionId;
+            aEvent.Reason = aReason;
+        });
+        return;
+    }
+
+    HandleDisconnection(aConnectionId, aReason);
+}
+
+void GameServer::HandleConnection(const ConnectionId_t aHandle)
 {
     spdlog::info("Connection received {:x}", aHandle);
+    ++m_connectionCount;
     UpdateTitle();
 }
 
-void GameServer::OnDisconnection(const ConnectionId_t aConnectionId, EDisconnectReason aReason)
+void GameServer::HandleDisconnection(const ConnectionId_t aConnectionId, EDisconnectReason aReason)
 {
     m_adminSessions.erase(aConnectionId);
+    m_inboundBatcher.Drop(aConnectionId);
+    m_outboundBundler.Drop(aConnectionId);
 
     auto* pPlayer = m_pWorld->GetPlayerManager().GetByConnectionId(aConnectionId);
 
@@ -449,59 +577,313 @@ void GameServer::OnDisconnection(const ConnectionId_t aConnectionId, EDisconnect
         m_pWorld->GetPlayerManager().Remove(pPlayer);
     }
 
+    --m_connectionCount;
     UpdateTitle();
 }
 
 void GameServer::Send(const ConnectionId_t aConnectionId, const ServerMessage& acServerMessage) const
 {
-    static thread_local TiltedPhoques::ScratchAllocator s_allocator{1 << 18};
+    const auto cData = SendBuffer::Get().Serialize(acServerMessage);
+    if (!cData.empty())
+        SendBundled(aConnectionId, cData.data(), cData.size());
+}
+
+void GameServer::Send(ConnectionId_t aConnectionId, const ServerAdminMessage& acServerMessage) const
+{
+    // The admin protocol doesn't know about bundles, only keep the order
+    FlushBundle(aConnectionId);
 
-    Buffer buffer(1 << 20);
-    Buffer::Writer writer(&buffer);
-    writer.WriteBits(0, 8); // Skip the first byte as it is used by packet
+    const auto cData = SendBuffer::Get().Serialize(acServerMessage);
+    if (!cData.empty())
+        SendPacket(aConnectionId, cData.data(), cData.size());
+}
 
-    acServerMessage.Serialize(writer);
+void GameServer::Send(ConnectionId_t aConnectionId, const TiltedPhoques::SharedPtr<SerializedMessage>& acpSerializedMessage) const
+{
+    // Nothing was serialized, the message was over the size limit
+    if (acpSerializedMessage->GetSize() == 0)
+        return;
 
-    TiltedPhoques::PacketView packet(reinterpret_cast<char*>(buffer.GetWriteData()), writer.Size());
+    // Small broadcasts are copied in the bundles, only large ones are worth sharing the payload
+    if (bBundleMessages && OutboundBundler::CanBundle(acpSerializedMessage->GetSize()))
+    {
+        SendBundled(aConnectionId, acpSerializedMessage->GetData(), acpSerializedMessage->GetSize());
+        return;
+    }
+
+    FlushBundle(aConnectionId);
+
+    if (m_pNetworkQueues)
+    {
+        // The network thread holds a reference until the packet is sent, no copy needed
+        m_pNetworkQueues->PushOutbound([aConnectionId, &acpSerializedMessage](OutboundNetworkCommand& aCommand) {
+            aCommand.Kind = OutboundNetworkCommand::Type::kSend;
+            aCommand.ConnectionId = aConnectionId;
+            aCommand.pShared = acpSerializedMessage;
+        });
+        return;
+    }
+
+    TiltedPhoques::PacketView packet(acpSerializedMessage->GetData(), acpSerializedMessage->GetSize());
     Server::Send(aConnectionId, &packet);
+}
 
-    s_allocator.Reset();
+void GameServer::SendPacket(ConnectionId_t aConnectionId, char* apData, size_t aSize) const
+{
+    if (m_pNetworkQueues)
+    {
+        m_pNetworkQueues->PushOutbound([aConnectionId, apData, aSize](OutboundNetworkCommand& aCommand) {
+            aCommand.Kind = OutboundNetworkCommand::Type::kSend;
+            aCommand.ConnectionId = aConnectionId;
+            aCommand.Payload.assign(apData, apData + aSize);
+        });
+        return;
+    }
+
+    TiltedPhoques::PacketView packet(apData, aSize);
+    Server::Send(aConnectionId, &packet);
 }
 
-void GameServer::Send(ConnectionId_t aConnectionId, const ServerAdminMessage& acServerMessage) const
+void GameServer::SendBundled(ConnectionId_t aConnectionId, char* apData, size_t aSize) const
 {
-    static thread_local TiltedPhoques::ScratchAllocator s_allocator{1 << 18};
+    if (!bBundleMessages || !OutboundBundler::CanBundle(aSize))
+    {
+        FlushBundle(aConnectionId);
+        SendPacket(aConnectionId, apData, aSize);
+        return;
+    }
 
-    Buffer buffer(1 << 20);
-    Buffer::Writer writer(&buffer);
-    writer.WriteBits(0, 8); // Skip the first byte as it is used by packet
+    m_outboundBundler.Append(aConnectionId, apData, aSize, [this](ConnectionId_t aId, char* apBundle, size_t aBundleSize) { SendPacket(aId, apBundle, aBundleSize); });
+}
 
-    acServerMessage.Serialize(writer);
+void GameServer::FlushBundle(ConnectionId_t aConnectionId) const
+{
+    m_outboundBundler.Flush(aConnectionId, [this](ConnectionId_t aId, char* apBundle, size_t aBundleSize) { SendPacket(aId, apBundle, aBundleSize); });
+}
 
-    TiltedPhoques::PacketView packet(reinterpret_cast<char*>(buffer.GetWriteData()), writer.Size());
-    Server::Send(aConnectionId, &packet);
+void GameServer::Kick(const ConnectionId_t aConnectionId)
+{
+    // Whatever is still bundled for the connection leaves before it is dropped
+    FlushBundle(aConnectionId);
 
-    s_allocator.Reset();
+    if (m_pNetworkQueues)
+    {
+        // Queued behind the packets sent before it, so a lingering kick message still goes out first
+        m_pNetworkQueues->PushOutbound([aConnectionId](OutboundNetworkCommand& aCommand) {
+            aCommand.Kind = OutboundNetworkCommand::Type::kKick;
+            aCommand.ConnectionId = aConnectionId;
+        });
+        return;
+    }
+
+    Server::Kick(aConnectionId);
 }
 
-void GameServer::SendToLoaded(const ServerMessage& acServerMessage) const
+void GameServer::StartNetworkThread()
 {
-    for (Player* pPlayer : m_pWorld->GetPlayerManager())
+    m_pNetworkQueues = MakeUnique<NetworkQueues>();
+    m_stopNetworkThread = false;
+    m_networkThread = std::thread(&GameServer::RunNetworkThread, this);
+
+    spdlog::info("Networking runs on a dedicated thread");
+}
+
+void GameServer::StopNetworkThread()
+{
+    if (!m_networkThread.joinable())
+        return;
+
+    m_stopNetworkThread = true;
+    m_networkThread.join();
+
+    // Send what the last tick queued, this thread owns the sockets from now on
+    do
+    {
+        FlushOutbound();
+    } while (!m_pNetworkQueues->FlushOutboundOverflow());
+
+    FlushOutbound();
+}
+
+void GameServer::RunNetworkThread()
+{
+    using namespace std::chrono_literals;
+
+    Base::SetCurrentThreadName("NetworkThread");
+
+    while (!m_stopNetworkThread)
     {
-        if (pPlayer->GetCellComponent())
-            pPlayer->Send(acServerMessage);
+        // Calls OnConsume, OnConnection and OnDisconnection, which queue what they get for the game thread
+        Update();
+        FlushOutbound();
+
+        std::this_thread::sleep_for(1ms);
     }
 }
 
-void GameServer::SendToPlayers(const ServerMessage& acServerMessage, const Player* apExcludedPlayer) const
+template <class TFunctor> void GameServer::PushInbound(const TFunctor& acFill) noexcept
+{
+    using namespace std::chrono_literals;
+
+    // The game thread never waits on the network thread, so it eventually makes room. Shutdown doesn't, it joins
+    // this thread, whatever is left is dropped then.
+    while (!NetworkQueues::TryPush(m_pNetworkQueues->Inbound, acFill))
+    {
+        if (m_stopNetworkThread)
+            return;
+
+        std::this_thread::sleep_for(1ms);
+    }
+}
+
+void GameServer::QueueMessage(Buffer::Reader& aReader, const ConnectionId_t aConnectionId)
+{
+    if (m_networkAdminSessions.contains(aConnectionId)) [[unlikely]]
+    {
+        auto pAdminMessage = ClientAdminMessageFactory{}.Extract(aReader);
+        if (!pAdminMessage)
+        {
+            spdlog::error("Couldn't parse packet from {:x}", aConnectionId);
+            return;
+        }
+
+        PushInbound([&](InboundNetworkEvent& aEvent) {
+            aEvent.Kind = InboundNetworkEvent::Type::kAdminMessage;
+            aEvent.ConnectionId = aConnectionId;
+            aEvent.pAdminMessage = std::move(pAdminMessage);
+        });
+
+        return;
+    }
+
+    // Client messages are decoded straight into the slot, which keeps its message around so the next message of
+    // the same type that lands there reuses it instead of allocating
+    PushInbound([&](InboundNetworkEvent& aEvent) {
+        aEvent.ConnectionId = aConnectionId;
+
+        if (ClientMessageFactory::DecodeInto(aReader, aEvent.pMessage))
+        {
+            aEvent.Kind = InboundNetworkEvent::Type::kMessage;
+            return;
+        }
+
+        aEvent.Kind = InboundNetworkEvent::Type::kDiscarded;
+        spdlog::error("Couldn't parse packet from {:x}", aConnectionId);
+    });
+}
+
+void GameServer::ProcessInbound()
 {
+    NetworkQueues::Drain(m_pNetworkQueues->Inbound, [this](InboundNetworkEvent& aEvent) {
+        switch (aEvent.Kind)
+        {
+        case InboundNetworkEvent::Type::kConnection:
+            HandleConnection(aEvent.ConnectionId);
+            break;
+        case InboundNetworkEvent::Type::kDisconnection:
+            HandleDisconnection(aEvent.ConnectionId, aEvent.Reason);
+            break;
+        case InboundNetworkEvent::Type::kMessage:
+        {
+            const auto cConnectionId = aEvent.ConnectionId;
+            ClientMessageFactory::Cast(*aEvent.pMessage, [this, cConnectionId](auto& aMessage) { HandleMessage(aMessage, cConnectionId); });
+            break;
+        }
+        case InboundNetworkEvent::Type::kAdminMessage:
+            m_adminMessageHandlers[aEvent.pAdminMessage->GetOpcode()](aEvent.pAdminMessage, aEvent.ConnectionId);
+            aEvent.pAdminMessage.reset();
+            break;
+        case InboundNetworkEvent::Type::kDiscarded:
+            break;
+        }
+    });
+}
+
+void GameServer::FlushOutbound()
+{
+    NetworkQueues::Drain(m_pNetworkQueues->Outbound, [this](OutboundNetworkCommand& aCommand) {
+        switch (aCommand.Kind)
+        {
+        case OutboundNetworkCommand::Type::kSend:
+            if (aCommand.pShared)
+            {
+                TiltedPhoques::PacketView packet(aCommand.pShared->GetData(), aCommand.pShared->GetSize());
+                Server::Send(aCommand.ConnectionId, &packet);
+                aCommand.pShared.reset();
+            }
+            else
+            {
+                TiltedPhoques::PacketView packet(aCommand.Payload.data(), aCommand.Payload.size());
+                Server::Send(aCommand.ConnectionId, &packet);
+            }
+            break;
+        case OutboundNetworkCommand::Type::kKick:
+            Server::Kick(aCommand.ConnectionId);
+            break;
+        case OutboundNetworkCommand::Type::kOpenAdminSession:
+            m_networkAdminSessions.insert(aCommand.ConnectionId);
+            break;
+        }
+    });
+}
+
+void GameServer::OpenAdminSession(const ConnectionId_t aConnectionId)
+{
+    m_adminSessions.insert(aConnectionId);
+
+    if (!m_pNetworkQueues)
+        return;
+
+    // Admin messages are told apart when they are decoded, on the network thread
+    m_pNetworkQueues->PushOutbound([aConnectionId](OutboundNetworkCommand& aCommand) {
+        aCommand.Kind = OutboundNetworkCommand::Type::kOpenAdminSession;
+        aCommand.ConnectionId = aConnectionId;
+    });
+}
+
+template <class T> void GameServer::Broadcast(const ServerMessage& acServerMessage, const T& acFilter) const
+{
+    TiltedPhoques::SharedPtr<SerializedMessage> pSerializedMessage;
+
     for (Player* pPlayer : m_pWorld->GetPlayerManager())
     {
-        if (pPlayer != apExcludedPlayer)
-            pPlayer->Send(acServerMessage);
+        if (!acFilter(pPlayer))
+            continue;
+
+        if (!pSerializedMessage)
+            pSerializedMessage = SerializedMessage::Create(acServerMessage);
+
+        Send(pPlayer->GetConnectionId(), pSerializedMessage);
     }
 }
 
+template <class T>
+void GameServer::BroadcastInRange(const ServerMessage& acServerMessage, const CellIdComponent& acOrigin, bool aIsDragon,
+                                  const T& acFilter) const
+{
+    TiltedPhoques::SharedPtr<SerializedMessage> pSerializedMessage;
+
+    m_pWorld->GetPlayerManager().GetWorldMap().ForEachPlayerInRange(acOrigin, aIsDragon, [&](Player* pPlayer) {
+        if (!acFilter(pPlayer))
+            return;
+
+        if (!pSerializedMessage)
+            pSerializedMessage = SerializedMessage::Create(acServerMessage);
+
+        Send(pPlayer->GetConnectionId(), pSerializedMessage);
+    });
+}
+
+void GameServer::SendToLoaded(const ServerMessage& acServerMessage) const
+{
+    Broadcast(acServerMessage, [](const Player* apPlayer) { return static_cast<bool>(apPlayer->GetCellComponent()); });
+}
+
+void GameServer::SendToPlayers(const ServerMessage& acServerMessage, const Player* apExcludedPlayer) const
+{
+    Broadcast(acServerMessage, [apExcludedPlayer](const Player* apPlayer) { return apPlayer != apExcludedPlayer; });
+}
+
 // NOTE: this doesn't check objects in range, only characters in range.
 void GameServer::SendToPlayersInRange(const ServerMessage& acServerMessage, const entt::entity acOrigin,
                                       const Player* apExcludedPlayer) const
@@ -527,11 +909,16 @@ void GameServer::SendToPlayersInRange(const ServerMessage& acServerMessage, cons
     if (const auto* characterComponent = m_pWorld->try_get<CharacterComponent>(acOrigin))
         isDragon = characterComponent->IsDragon();
 
-    for (Player* pPlayer : m_pWorld->GetPlayerManager())
-    {
-        if (cellComponent.IsInRange(pPlayer->GetCellComponent(), isDragon) && pPlayer != apExcludedPlayer)
-            pPlayer->Send(acServerMessage);
-    }
+    BroadcastInRange(acServerMessage, cellComponent, isDragon,
+                     [apExcludedPlayer](const Player* apPlayer) { return apPlayer != apExcludedPlayer; });
+}
+
+void GameServer::SendToCell(const ServerMessage& acServerMessage, const GameId& acCellId,
+                            const Player* apExcludeSender) const
+{
+    Broadcast(acServerMessage, [&acCellId, apExcludeSender](const Player* apPlayer) {
+        return apPlayer != apExcludeSender && apPlayer->GetCellComponent().Cell == acCellId;
+    });
 }
 
 void GameServer::SendToParty(const ServerMessage& acServerMessage, const PartyComponent& acPartyComponent,
@@ -543,17 +930,9 @@ void GameServer::SendToParty(const ServerMessage& acServerMessage, const PartyCo
         return;
     }
 
-    for (Player* pPlayer : m_pWorld->GetPlayerManager())
-    {
-        if (pPlayer == apExcludeSender)
-            continue;
-
-        const auto& partyComponent = pPlayer->GetParty();
-        if (partyComponent.JoinedPartyId == acPartyComponent.JoinedPartyId)
-        {
-            pPlayer->Send(acServerMessage);
-        }
-    }
+    Broadcast(acServerMessage, [&acPartyComponent, apExcludeSender](Player* apPlayer) {
+        return apPlayer != apExcludeSender && apPlayer->GetParty().JoinedPartyId == acPartyComponent.JoinedPartyId;
+    });
 }
 
 void GameServer::SendToPartyInRange(const ServerMessage& acServerMessage, const PartyComponent& acPartyComponent,
@@ -576,19 +955,9 @@ void GameServer::SendToPartyInRange(const ServerMessage& acServerMessage, const
 
     const auto& cellComponent = view.get<CellIdComponent>(*it);
 
-    for (Player* pPlayer : m_pWorld->GetPlayerManager())
-    {
-        if (pPlayer == apExcludeSender)
-            continue;
-
-        if (!cellComponent.IsInRange(pPlayer->GetCellComponent(), false))
-            continue;
-
-        if (pPlayer->GetParty().JoinedPartyId != acPartyComponent.JoinedPartyId)
-            continue;
-
-        pPlayer->Send(acServerMessage);
-    }
+    BroadcastInRange(acServerMessage, cellComponent, false, [&acPartyComponent, apExcludeSender](Player* apPlayer) {
+        return apPlayer != apExcludeSender && apPlayer->GetParty().JoinedPartyId == acPartyComponent.JoinedPartyId;
+    });
 }
 
 static String PrettyPrintModList(const Vector<Mods::Entry>& acMods)
@@ -604,13 +973,12 @@ static String PrettyPrintModList(const Vector<Mods::Entry>& acMods)
     return text;
 }
 
-bool GameServer::ValidateAuthParams(ConnectionId_t aConnectionId, const UniquePtr<AuthenticationRequest>& acRequest)
+bool GameServer::ValidateAuthParams(ConnectionId_t aConnectionId, const AuthenticationRequest& acRequest)
 {
     return false;
 }
 
-void GameServer::HandleAuthenticationRequest(const ConnectionId_t aConnectionId,
-                                             const UniquePtr<AuthenticationRequest>& acRequest)
+void GameServer::HandleAuthenticationRequest(const ConnectionId_t aConnectionId, const AuthenticationRequest& acRequest)
 {
     const auto info = GetConnectionInfo(aConnectionId);
 
@@ -629,10 +997,10 @@ void GameServer::HandleAuthenticationRequest(const ConnectionId_t aConnectionId,
     };
 #if 1
     // to make our testing life a bit easier.
-    if (acRequest->Version != BUILD_COMMIT)
+    if (acRequest.Version != BUILD_COMMIT)
     {
         spdlog::info("New player {:x} '{}' tried to connect with client {} - Version mismatch", aConnectionId,
-                     remoteAddress, acRequest->Version.c_str());
+                     remoteAddress, acRequest.Version.c_str());
         sendKick(RT::kWrongVersion);
         return;
     }
@@ -644,8 +1012,8 @@ void GameServer::HandleAuthenticationRequest(const ConnectionId_t aConnectionId,
         return;
     }
 
-    bool skseProblem = !bAllowSKSE && acRequest->SKSEActive;
-    bool mo2Problem = !bAllowMO2 && acRequest->MO2Active;
+    bool skseProblem = !bAllowSKSE && acRequest.SKSEActive;
+    bool mo2Problem = !bAllowMO2 && acRequest.MO2Active;
 
     if (skseProblem || mo2Problem)
     {
@@ -658,14 +1026,14 @@ void GameServer::HandleAuthenticationRequest(const ConnectionId_t aConnectionId,
         spdlog::info("New player {:x} '{}' tried to connect, but {}{} disallowed - Kicked.", aConnectionId,
                      remoteAddress, response.c_str(), skseProblem && mo2Problem ? "are" : "is");
 
-        serverResponse.SKSEActive = acRequest->SKSEActive;
-        serverResponse.MO2Active = acRequest->MO2Active;
+        serverResponse.SKSEActive = acRequest.SKSEActive;
+        serverResponse.MO2Active = acRequest.MO2Active;
         sendKick(RT::kClientModsDisallowed);
         return;
     }
 
     // check if the proper server password was supplied.
-    if (acRequest->Token == sPassword.value())
+    if (acRequest.Token == sPassword.value())
     {
         Mods& responseList = serverResponse.UserMods;
         auto& modsComponent = m_pWorld->ctx().at<ModsComponent>();
@@ -676,7 +1044,7 @@ void GameServer::HandleAuthenticationRequest(const ConnectionId_t aConnectionId,
             // modscomponent contains a list filled in by the recordcollection
             Mods modsToRemove;
 
-            const auto& userMods = acRequest->UserMods.ModList;
+            const auto& userMods = acRequest.UserMods.ModList;
             for (const Mods::Entry& mod : userMods)
             {
                 // if the client has more mods than the server..
@@ -727,7 +1095,7 @@ void GameServer::HandleAuthenticationRequest(const ConnectionId_t aConnectionId,
         Vector<uint16_t> playerModsIds;
 
         size_t i = 0;
-        for (auto& mod : acRequest->UserMods.ModList)
+        for (auto& mod : acRequest.UserMods.ModList)
         {
             const uint32_t id =
                 mod.IsLite ? modsComponent.AddLite(mod.Filename) : modsComponent.AddStandard(mod.Filename);
@@ -744,17 +1112,17 @@ void GameServer::HandleAuthenticationRequest(const ConnectionId_t aConnectionId,
 
         auto* pPlayer = m_pWorld->GetPlayerManager().Create(aConnectionId);
         pPlayer->SetEndpoint(remoteAddress);
-        pPlayer->SetDiscordId(acRequest->DiscordId);
-        pPlayer->SetUsername(std::move(acRequest->Username));
+        pPlayer->SetDiscordId(acRequest.DiscordId);
+        pPlayer->SetUsername(acRequest.Username);
         pPlayer->SetMods(playerMods);
         pPlayer->SetModIds(playerModsIds);
-        pPlayer->SetLevel(acRequest->Level);
+        pPlayer->SetLevel(acRequest.Level);
 
         serverResponse.PlayerId = pPlayer->GetId();
 
-        auto modList = PrettyPrintModList(acRequest->UserMods.ModList);
+        auto modList = PrettyPrintModList(acRequest.UserMods.ModList);
         spdlog::info("New player '{}' [{:x}] connected with {} mods\n\t: {}", pPlayer->GetUsername().c_str(), aConnectionId,
-                     acRequest->UserMods.ModList.size(), modList.c_str());
+                     acRequest.UserMods.ModList.size(), modList.c_str());
 
         serverResponse.Settings = GetSettings();
 
@@ -788,15 +1156,15 @@ void GameServer::HandleAuthenticationRequest(const ConnectionId_t aConnectionId,
             Send(pPlayer->GetConnectionId(), notify);
         }
 
-        m_pWorld->GetDispatcher().trigger(PlayerJoinEvent(pPlayer, acRequest->WorldSpaceId, acRequest->CellId));
+        m_pWorld->GetDispatcher().trigger(PlayerJoinEvent(pPlayer, acRequest.WorldSpaceId, acRequest.CellId));
     }
 /*
-    else if (acRequest->Token == sAdminPassword.value() && !sAdminPassword.empty())
+    else if (acRequest.Token == sAdminPassword.value() && !sAdminPassword.empty())
     {
         AdminSessionOpen response;
         Send(aConnectionId, response);
 
-        m_adminSessions.insert(aConnectionId);
+        OpenAdminSession(aConnectionId);
         spdlog::warn("New admin session for {:x} '{}'", aConnectionId, remoteAddress);
     }
 */
@@ -818,10 +1186,10 @@ void GameServer::UpdateSettings()
 void GameServer::UpdateTitle() const
 {
     const auto name = m_info.name.empty() ? "Private server" : m_info.name;
-    const char* playerText = GetClientCount() <= 1 ? " player" : " players";
+    const char* playerText = m_connectionCount <= 1 ? " player" : " players";
 
     const auto title = fmt::format("{} - {} {} - {} Ticks - " BUILD_BRANCH "@" BUILD_COMMIT, name.c_str(),
-                                   GetClientCount(), playerText, GetTickRate());
+                                   m_connectionCount, playerText, GetTickRate());
 
 #if TP_PLATFORM_WINDOWS
     SetConsoleTitleA(title.c_str());
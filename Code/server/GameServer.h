@@ -3,8 +3,12 @@
 #include <AdminMessages/Message.h>
 #include <Messages/AuthenticationRequest.h>
 #include <Messages/Message.h>
+#include <Network/InboundBatcher.h>
+#include <Network/OutboundBundler.h>
 #include <World.h>
 
+#include <thread>
+
 using TiltedPhoques::ConnectionId_t;
 using TiltedPhoques::Server;
 using TiltedPhoques::String;
@@ -12,6 +16,8 @@ using TiltedPhoques::String;
 struct AuthenticationRequest;
 struct Player;
 struct PartyComponent;
+struct SerializedMessage;
+struct NetworkQueues;
 
 namespace Console
 {
@@ -39,6 +45,10 @@ struct GameServer final : Server
 
     void Initialize();
     void Kill();
+    // Runs one server tick, polling the sockets too unless a network thread does it
+    void Tick();
+    // Hides Server::Kick, kicks have to be queued when the network runs on its own thread
+    void Kick(ConnectionId_t aConnectionId);
 
     bool CheckMoPo();
     void BindMessageHandlers();
@@ -51,15 +61,23 @@ struct GameServer final : Server
     // Packet dispatching
     void Send(ConnectionId_t aConnectionId, const ServerMessage& acServerMessage) const;
     void Send(ConnectionId_t aConnectionId, const ServerAdminMessage& acServerMessage) const;
+    void Send(ConnectionId_t aConnectionId, const TiltedPhoques::SharedPtr<SerializedMessage>& acpSerializedMessage) const;
     void SendToLoaded(const ServerMessage& acServerMessage) const;
     void SendToPlayers(const ServerMessage& acServerMessage, const Player* apExcludeSender = nullptr) const;
     void SendToPlayersInRange(const ServerMessage& acServerMessage, const entt::entity acOrigin,
                               const Player* apExcludeSender = nullptr) const;
+    void SendToCell(const ServerMessage& acServerMessage, const GameId& acCellId,
+                    const Player* apExcludeSender = nullptr) const;
     void SendToParty(const ServerMessage& acServerMessage, const PartyComponent& acPartyComponent,
                      const Player* apExcludeSender = nullptr) const;
     void SendToPartyInRange(const ServerMessage& acServerMessage, const PartyComponent& acPartyComponent,
                             const entt::entity acOrigin, const Player* apExcludeSender = nullptr) const;
 
+    World& GetWorld() noexcept
+    {
+        return *m_pWorld;
+    }
+
     const Info& GetInfo() const noexcept
     {
         return m_info;
@@ -81,8 +99,8 @@ struct GameServer final : Server
     }
 
 protected:
-    bool ValidateAuthParams(ConnectionId_t aConnectionId, const UniquePtr<AuthenticationRequest>& acRequest);
-    void HandleAuthenticationRequest(ConnectionId_t aConnectionId, const UniquePtr<AuthenticationRequest>& acRequest);
+    bool ValidateAuthParams(ConnectionId_t aConnectionId, const AuthenticationRequest& acRequest);
+    void HandleAuthenticationRequest(ConnectionId_t aConnectionId, const AuthenticationRequest& acRequest);
 
     // Implement TiltedPhoques::Server
     void OnUpdate() override;
@@ -92,11 +110,46 @@ protected:
 
 private:
     void UpdateTitle() const;
+    void Simulate();
+
+    void HandleConnection(ConnectionId_t aHandle);
+    void HandleDisconnection(ConnectionId_t aConnectionId, EDisconnectReason aReason);
+    void OpenAdminSession(ConnectionId_t aConnectionId);
+    // Batches state updates or dispatches the message right away
+    template <class T> void HandleMessage(T& aMessage, ConnectionId_t aConnectionId) noexcept;
+    void SendPacket(ConnectionId_t aConnectionId, char* apData, size_t aSize) const;
+    // Queues a serialized game message in the connection's bundle, see bBundleMessages
+    void SendBundled(ConnectionId_t aConnectionId, char* apData, size_t aSize) const;
+    void FlushBundle(ConnectionId_t aConnectionId) const;
+
+    // Network thread, see bNetworkThread. The network thread polls the sockets, decodes and sends, the game
+    // thread only sees connection events and decoded messages.
+    void StartNetworkThread();
+    void StopNetworkThread();
+    void RunNetworkThread();
+    // Called on the network thread
+    template <class TFunctor> void PushInbound(const TFunctor& acFill) noexcept;
+    void QueueMessage(TiltedPhoques::Buffer::Reader& aReader, ConnectionId_t aConnectionId);
+    void FlushOutbound();
+    // Called on the game thread
+    void ProcessInbound();
+
+    // Hands a decoded client message to its handlers
+    template <class T> void Dispatch(T& aMessage, ConnectionId_t aConnectionId) noexcept;
+
+    // Serializes the message once, on the first player accepted by the filter, and sends that payload to everyone accepted.
+    template <class T> void Broadcast(const ServerMessage& acServerMessage, const T& acFilter) const;
+    // Same as Broadcast but only considers the players for which acOrigin.IsInRange() holds.
+    template <class T>
+    void BroadcastInRange(const ServerMessage& acServerMessage, const CellIdComponent& acOrigin, bool aIsDragon,
+                          const T& acFilter) const;
 
 private:
     std::chrono::high_resolution_clock::time_point m_lastFrameTime;
-    std::function<void(UniquePtr<ClientMessage>&, ConnectionId_t)> m_messageHandlers[kClientOpcodeMax];
     std::function<void(UniquePtr<ClientAdminMessage>&, ConnectionId_t)> m_adminMessageHandlers[kClientAdminOpcodeMax];
+    InboundBatcher m_inboundBatcher;
+    // Sending is const, bundling what is sent isn't observable state
+    mutable OutboundBundler m_outboundBundler;
 
     bool m_isPasswordProtected{};
 
@@ -105,6 +158,14 @@ private:
     Console::ConsoleRegistry& m_commands;
 
     TiltedPhoques::Set<ConnectionId_t> m_adminSessions;
+    // Mirrors the client count on the game thread, the server's own count belongs to the network thread
+    uint32_t m_connectionCount{0};
+    // Null unless the network runs on its own thread
+    UniquePtr<NetworkQueues> m_pNetworkQueues;
+    std::thread m_networkThread;
+    std::atomic<bool> m_stopNetworkThread{false};
+    // Only touched by the network thread
+    TiltedPhoques::Set<ConnectionId_t> m_networkAdminSessions;
     TiltedPhoques::Map<ConnectionId_t, entt::entity> m_connectionToEntity;
 
     bool m_requestStop;
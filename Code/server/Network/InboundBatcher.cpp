@@ -0,0 +1,80 @@
+#include <Network/InboundBatcher.h>
+
+void InboundBatcher::Merge(const ConnectionId_t aConnectionId, const ClientReferencesMoveRequest& acMessage) noexcept
+{
+    auto& merged = GetBatch(aConnectionId).Movement;
+    if (!merged.Updates.empty())
+        ++m_mergedCount;
+
+    merged.Tick = acMessage.Tick;
+
+    for (const auto& [id, update] : acMessage.Updates)
+    {
+        auto [itor, inserted] = merged.Updates.try_emplace(id, update);
+        if (inserted)
+            continue;
+
+        // Movement is state, the latest one wins, actions are events and all of them are replayed
+        auto& mergedUpdate = itor.value();
+        mergedUpdate.UpdatedMovement = update.UpdatedMovement;
+        mergedUpdate.IsDelta = update.IsDelta;
+        mergedUpdate.MovementChanges = update.MovementChanges;
+        mergedUpdate.VariableChanges = update.VariableChanges;
+        mergedUpdate.ActionEvents.insert(std::end(mergedUpdate.ActionEvents), std::begin(update.ActionEvents), std::end(update.ActionEvents));
+    }
+}
+
+void InboundBatcher::Merge(const ConnectionId_t aConnectionId, const RequestActorValueChanges& acMessage) noexcept
+{
+    auto [itor, inserted] = GetBatch(aConnectionId).ActorValues.try_emplace(acMessage.Id, acMessage);
+    if (inserted)
+        return;
+
+    ++m_mergedCount;
+    for (const auto& [id, value] : acMessage.Values)
+        itor.value().Values[id] = value;
+}
+
+void InboundBatcher::Merge(const ConnectionId_t aConnectionId, const RequestActorMaxValueChanges& acMessage) noexcept
+{
+    auto [itor, inserted] = GetBatch(aConnectionId).ActorMaxValues.try_emplace(acMessage.Id, acMessage);
+    if (inserted)
+        return;
+
+    ++m_mergedCount;
+    for (const auto& [id, value] : acMessage.Values)
+        itor.value().Values[id] = value;
+}
+
+void InboundBatcher::Merge(const ConnectionId_t aConnectionId, const RequestFactionsChanges& acMessage) noexcept
+{
+    auto& merged = GetBatch(aConnectionId).Factions;
+    if (!merged.Changes.empty())
+        ++m_mergedCount;
+
+    for (const auto& [id, factions] : acMessage.Changes)
+        merged.Changes[id] = factions;
+}
+
+void InboundBatcher::Drop(const ConnectionId_t aConnectionId) noexcept
+{
+    if (m_flushing == aConnectionId)
+    {
+        m_dropFlushed = true;
+        return;
+    }
+
+    m_batches.erase(aConnectionId);
+}
+
+InboundBatcher::Batch& InboundBatcher::GetBatch(const ConnectionId_t aConnectionId) noexcept
+{
+    Batch& batch = m_batches[aConnectionId];
+    if (!batch.Pending)
+    {
+        batch.Pending = true;
+        m_pending.push_back(aConnectionId);
+    }
+
+    return batch;
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <Messages/ClientReferencesMoveRequest.h>
+#include <Messages/RequestActorMaxValueChanges.h>
+#include <Messages/RequestActorValueChanges.h>
+#include <Messages/RequestFactionsChanges.h>
+
+using TiltedPhoques::ConnectionId_t;
+
+/**
+* @brief Holds back the state updates a connection sends during a tick and merges the ones that supersede each other.
+*
+* Movement, actor value and faction updates carry the latest state of what they touch, so after a client hitch
+* only the merged result of the burst is worth applying. Any other message flushes the connection's pending
+* updates before it is dispatched, the order the client sent things in is kept.
+*/
+struct InboundBatcher
+{
+    InboundBatcher() noexcept = default;
+    ~InboundBatcher() noexcept = default;
+
+    TP_NOCOPYMOVE(InboundBatcher);
+
+    // Whether messages of this type go through Merge instead of being dispatched right away
+    template <class T>
+    static constexpr bool IsBatched = std::is_same_v<T, ClientReferencesMoveRequest> || std::is_same_v<T, RequestActorValueChanges> ||
+                                      std::is_same_v<T, RequestActorMaxValueChanges> || std::is_same_v<T, RequestFactionsChanges>;
+
+    void Merge(ConnectionId_t aConnectionId, const ClientReferencesMoveRequest& acMessage) noexcept;
+    void Merge(ConnectionId_t aConnectionId, const RequestActorValueChanges& acMessage) noexcept;
+    void Merge(ConnectionId_t aConnectionId, const RequestActorMaxValueChanges& acMessage) noexcept;
+    void Merge(ConnectionId_t aConnectionId, const RequestFactionsChanges& acMessage) noexcept;
+
+    // Calls acDispatch with each merged message of the connection, then forgets them
+    template <class T>
+    void Flush(ConnectionId_t aConnectionId, const T& acDispatch) noexcept
+    {
+        const auto itor = m_batches.find(aConnectionId);
+        if (itor == std::end(m_batches) || !itor->second.Pending)
+            return;
+
+        // Handlers may kick the connection, Drop then leaves the batch alone until we are done with it
+        m_flushing = aConnectionId;
+
+        Batch& batch = itor.value();
+        if (!batch.Movement.Updates.empty())
+            acDispatch(batch.Movement);
+        for (auto& [id, message] : batch.ActorValues)
+            acDispatch(message);
+        for (auto& [id, message] : batch.ActorMaxValues)
+            acDispatch(message);
+        if (!batch.Factions.Changes.empty())
+            acDispatch(batch.Factions);
+
+        m_flushing.reset();
+
+        if (m_dropFlushed)
+        {
+            m_dropFlushed = false;
+            m_batches.erase(aConnectionId);
+            return;
+        }
+
+        // Keep the containers around, the same connections send the same updates every tick
+        batch.Movement.Updates.clear();
+        batch.ActorValues.clear();
+        batch.ActorMaxValues.clear();
+        batch.Factions.Changes.clear();
+        batch.Pending = false;
+    }
+
+    // Flushes every connection, acDispatch also gets the connection the message came from
+    template <class T>
+    void FlushAll(const T& acDispatch) noexcept
+    {
+        std::swap(m_pending, m_flushQueue);
+
+        for (const ConnectionId_t cConnectionId : m_flushQueue)
+            Flush(cConnectionId, [&acDispatch, cConnectionId](auto& aMessage) { acDispatch(aMessage, cConnectionId); });
+
+        m_flushQueue.clear();
+    }
+
+    // Discards whatever the connection had pending, for connections that went away
+    void Drop(ConnectionId_t aConnectionId) noexcept;
+
+    // Messages merged into another one since the server started
+    [[nodiscard]] uint64_t GetMergedCount() const noexcept { return m_mergedCount; }
+
+private:
+
+    struct Batch
+    {
+        bool Pending{false};
+        ClientReferencesMoveRequest Movement;
+        // By actor
+        Map<uint32_t, RequestActorValueChanges> ActorValues;
+        Map<uint32_t, RequestActorMaxValueChanges> ActorMaxValues;
+        RequestFactionsChanges Factions;
+    };
+
+    Batch& GetBatch(ConnectionId_t aConnectionId) noexcept;
+
+    Map<ConnectionId_t, Batch> m_batches;
+    Vector<ConnectionId_t> m_pending;
+    Vector<ConnectionId_t> m_flushQueue;
+    std::optional<ConnectionId_t> m_flushing;
+    bool m_dropFlushed{false};
+    uint64_t m_mergedCount{0};
+};
@@ -0,0 +1,80 @@
+#include <Network/MovementMessageBuilder.h>
+
+void MovementMessageBuilder::Begin() noexcept
+{
+    m_updates.clear();
+    m_checkpoint.reset();
+
+    m_writer.emplace(&m_buffer);
+    for (size_t i = 0; i < kMaxHeaderSize; ++i)
+        m_writer->WriteBits(0, 8);
+}
+
+size_t MovementMessageBuilder::Append(uint32_t aServerId, ReferenceUpdate&& aUpdate) noexcept
+{
+    const size_t cStart = m_writer->Size();
+    m_checkpoint.emplace(*m_writer);
+
+    m_updates.emplace_back(aServerId, std::move(aUpdate));
+    Serialize(m_updates.size() - 1);
+
+    // A write that doesn't fit is dropped and the writer carries on, only trust what used half of the buffer
+    if (m_writer->Size() > m_buffer.GetSize() / 2)
+    {
+        Grow();
+        return m_writer->Size() - m_checkpoint->Size();
+    }
+
+    return m_writer->Size() - cStart;
+}
+
+void MovementMessageBuilder::Rollback() noexcept
+{
+    // The writer overwrites what follows its position, going back to a copy of it is enough
+    m_writer.emplace(*m_checkpoint);
+    m_checkpoint.reset();
+    m_updates.pop_back();
+}
+
+std::span<const char> MovementMessageBuilder::Finish(uint64_t aTick) noexcept
+{
+    uint8_t header[kMaxHeaderSize];
+    TiltedPhoques::ViewBuffer headerBuffer(header, sizeof(header));
+
+    Buffer::Writer writer(&headerBuffer);
+    writer.WriteBits(0, 8); // Skip the first byte as it is used by packet
+    ServerReferencesMoveRequest::SerializeHeader(writer, aTick, m_updates.size());
+
+    const size_t cHeaderSize = writer.Size();
+    char* pData = reinterpret_cast<char*>(m_buffer.GetWriteData());
+    std::memcpy(pData + kMaxHeaderSize - cHeaderSize, header, cHeaderSize);
+
+    return {pData + kMaxHeaderSize - cHeaderSize, m_writer->Size() - kMaxHeaderSize + cHeaderSize};
+}
+
+void MovementMessageBuilder::Serialize(size_t aIndex) noexcept
+{
+    const auto& [cServerId, cUpdate] = m_updates[aIndex];
+    ServerReferencesMoveRequest::SerializeUpdate(*m_writer, cServerId, cUpdate);
+}
+
+void MovementMessageBuilder::Grow() noexcept
+{
+    // Rare, the buffer keeps its size for the next messages built on this thread
+    do
+    {
+        m_buffer.Resize(m_buffer.GetSize() * 2);
+
+        m_writer.emplace(&m_buffer);
+        for (size_t i = 0; i < kMaxHeaderSize; ++i)
+            m_writer->WriteBits(0, 8);
+
+        for (size_t i = 0; i < m_updates.size(); ++i)
+        {
+            if (i + 1 == m_updates.size())
+                m_checkpoint.emplace(*m_writer);
+
+            Serialize(i);
+        }
+    } while (m_writer->Size() > m_buffer.GetSize() / 2);
+}
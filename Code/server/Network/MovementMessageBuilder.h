@@ -0,0 +1,47 @@
+#pragma once
+
+#include <Messages/ServerReferencesMoveRequest.h>
+
+#include <span>
+
+using TiltedPhoques::Buffer;
+
+/**
+* @brief Builds a ServerReferencesMoveRequest one update at a time, straight in its serialized form.
+*
+* Each update is serialized once, after room left for the header, and can be rolled back when it turns out to be
+* over a budget. The header only holds whole bytes, it is written in front of the updates once their count is known.
+* Updates are kept until the message is finished so they can be serialized again if the buffer has to grow.
+*/
+struct MovementMessageBuilder
+{
+    // Packet byte, opcode and two var ints
+    static constexpr size_t kMaxHeaderSize = 1 + sizeof(ServerOpcode) + 10 + 10;
+
+    MovementMessageBuilder() noexcept = default;
+    ~MovementMessageBuilder() noexcept = default;
+
+    TP_NOCOPYMOVE(MovementMessageBuilder);
+
+    void Begin() noexcept;
+    // Returns the serialized size of the update in bytes
+    size_t Append(uint32_t aServerId, ReferenceUpdate&& aUpdate) noexcept;
+    // Removes the update appended last, only one step back is possible
+    void Rollback() noexcept;
+
+    [[nodiscard]] bool IsEmpty() const noexcept { return m_updates.empty(); }
+    [[nodiscard]] const ReferenceUpdate& GetLast() const noexcept { return m_updates.back().second; }
+
+    // The view includes the leading byte reserved by the packet and stays valid until the next Begin
+    std::span<const char> Finish(uint64_t aTick) noexcept;
+
+private:
+
+    void Serialize(size_t aIndex) noexcept;
+    void Grow() noexcept;
+
+    Buffer m_buffer{1 << 16};
+    std::optional<Buffer::Writer> m_writer;
+    std::optional<Buffer::Writer> m_checkpoint;
+    Vector<std::pair<uint32_t, ReferenceUpdate>> m_updates;
+};
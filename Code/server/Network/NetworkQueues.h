@@ -0,0 +1,118 @@
+#pragma once
+
+#include <base/containers/fast_queue.hpp>
+
+#include <AdminMessages/Message.h>
+#include <Messages/Message.h>
+#include <Network/SerializedMessage.h>
+
+using TiltedPhoques::ConnectionId_t;
+
+/**
+* @brief Something the network thread received for the game thread.
+*/
+struct InboundNetworkEvent
+{
+    enum class Type : uint8_t
+    {
+        kConnection,
+        kDisconnection,
+        kMessage,
+        kAdminMessage,
+        // A message that failed to decode, the slot was already taken
+        kDiscarded
+    };
+
+    Type Kind{Type::kMessage};
+    ConnectionId_t ConnectionId{};
+    EDisconnectReason Reason{};
+    // Kept after the event is handled, decoding the next message of the same type into this slot reuses it
+    UniquePtr<ClientMessage> pMessage;
+    UniquePtr<ClientAdminMessage> pAdminMessage;
+};
+
+/**
+* @brief Something the game thread wants the network thread to do with a connection.
+*/
+struct OutboundNetworkCommand
+{
+    enum class Type : uint8_t
+    {
+        kSend,
+        kKick,
+        kOpenAdminSession
+    };
+
+    Type Kind{Type::kSend};
+    ConnectionId_t ConnectionId{};
+    // Broadcasts share the serialized message, everything else is copied in Payload
+    TiltedPhoques::SharedPtr<SerializedMessage> pShared;
+    Vector<char> Payload;
+};
+
+/**
+* @brief Lock free queues between the network thread and the game thread.
+*
+* Each direction has a single producer and a single consumer. Queue entries are reused in place, so the payload
+* vectors keep their capacity and steady state sends don't allocate. The network thread waits when the inbound
+* queue is full, the game thread never does: outbound commands that don't fit are kept aside and queued in order
+* once there is room, so both threads can't end up waiting on each other.
+*/
+struct NetworkQueues
+{
+    // 16k entries per direction, a few ticks worth of traffic for a full server
+    static constexpr size_t kExponent = 14;
+
+    template <class T> using Queue = fast_queue<T, kExponent>;
+
+    // Calls acFunctor on every entry published so far and never waits, an entry the producer is still filling is
+    // left for the next drain. Must only be called by the consumer of the queue
+    template <class T, class TFunctor> static void Drain(Queue<T>& aQueue, const TFunctor& acFunctor) noexcept
+    {
+        T* pEntry = nullptr;
+        while (auto lock = aQueue.try_read_acquire(pEntry))
+            acFunctor(*pEntry);
+    }
+
+    // Returns false without calling acFill if the queue is full, must only be called by the producer of the queue
+    template <class T, class TFunctor> static bool TryPush(Queue<T>& aQueue, const TFunctor& acFill) noexcept
+    {
+        if (aQueue.full())
+            return false;
+
+        T* pEntry = nullptr;
+        auto lock = aQueue.write_acquire(pEntry);
+        acFill(*pEntry);
+        return true;
+    }
+
+    // Game thread only, never waits
+    template <class TFunctor> void PushOutbound(const TFunctor& acFill) noexcept
+    {
+        FlushOutboundOverflow();
+
+        if (OutboundOverflow.empty() && TryPush(Outbound, acFill))
+            return;
+
+        acFill(OutboundOverflow.emplace_back());
+    }
+
+    // Moves the commands kept aside to the queue, as many as fit. Returns true once none are left
+    bool FlushOutboundOverflow() noexcept
+    {
+        size_t count = 0;
+        while (count < OutboundOverflow.size() &&
+               TryPush(Outbound, [this, count](OutboundNetworkCommand& aCommand) { aCommand = std::move(OutboundOverflow[count]); }))
+        {
+            ++count;
+        }
+
+        OutboundOverflow.erase(std::begin(OutboundOverflow), std::begin(OutboundOverflow) + count);
+        return OutboundOverflow.empty();
+    }
+
+    Queue<InboundNetworkEvent> Inbound;
+    Queue<OutboundNetworkCommand> Outbound;
+    // Outbound commands waiting for room in the queue, oldest first
+    Vector<OutboundNetworkCommand> OutboundOverflow;
+};
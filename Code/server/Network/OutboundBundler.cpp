@@ -0,0 +1,31 @@
+#include <Network/OutboundBundler.h>
+
+void OutboundBundler::Drop(const ConnectionId_t aConnectionId) noexcept
+{
+    m_bundles.erase(aConnectionId);
+}
+
+void OutboundBundler::Write(Bundle& aBundle, const char* apData, size_t aSize) noexcept
+{
+    if (aBundle.Count == 0)
+    {
+        aBundle.Data.assign(kHeaderSize, 0);
+        aBundle.Data[kHeaderSize - 1] = static_cast<char>(kServerMessageBundle);
+    }
+
+    // The packet byte isn't part of the message
+    const auto* pMessage = apData + 1;
+    const size_t cMessageSize = aSize - 1;
+
+    const size_t cOffset = aBundle.Data.size();
+    aBundle.Data.resize(cOffset + MessageBundle::kMaxSizePrefix + cMessageSize);
+
+    const size_t cPrefixSize = MessageBundle::WriteSize(reinterpret_cast<uint8_t*>(aBundle.Data.data() + cOffset), static_cast<uint32_t>(cMessageSize));
+    std::memcpy(aBundle.Data.data() + cOffset + cPrefixSize, pMessage, cMessageSize);
+    aBundle.Data.resize(cOffset + cPrefixSize + cMessageSize);
+
+    if (aBundle.Count == 0)
+        aBundle.FirstMessage = cOffset + cPrefixSize;
+
+    ++aBundle.Count;
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <MessageBundle.h>
+
+using TiltedPhoques::ConnectionId_t;
+
+/**
+* @brief Packs the game messages sent to a connection during a tick into as few packets as possible.
+*
+* Messages are appended to the connection's bundle in the order they are sent, bundles go out once per tick or as
+* soon as the next message would push them past kMaxBundleSize. A bundle holding a single message is sent as that
+* message alone. Messages too large to share a datagram are never bundled, the caller flushes the connection and
+* sends them on their own so the order is kept.
+*
+* Send functors are called as acSend(connection, data, size) with data starting at the byte reserved for the packet.
+*/
+struct OutboundBundler
+{
+    // Payload that stays within a single datagram once the transport adds its headers
+    static constexpr size_t kMaxBundleSize = 1100;
+    // Packet byte and bundle opcode
+    static constexpr size_t kHeaderSize = 1 + MessageBundle::kHeaderSize;
+
+    OutboundBundler() noexcept = default;
+    ~OutboundBundler() noexcept = default;
+
+    TP_NOCOPYMOVE(OutboundBundler);
+
+    // Whether a message of aSize bytes, packet byte included, can share a bundle
+    [[nodiscard]] static constexpr bool CanBundle(size_t aSize) noexcept
+    {
+        return aSize > 1 && kHeaderSize + MessageBundle::kMaxSizePrefix + aSize - 1 <= kMaxBundleSize;
+    }
+
+    // Appends a message that passes CanBundle, sends the connection's bundle first if the message doesn't fit in it
+    template <class T> void Append(ConnectionId_t aConnectionId, const char* apData, size_t aSize, const T& acSend) noexcept
+    {
+        Bundle& bundle = m_bundles[aConnectionId];
+
+        if (bundle.Count > 0 && bundle.Data.size() + MessageBundle::kMaxSizePrefix + aSize - 1 > kMaxBundleSize)
+            Send(aConnectionId, bundle, acSend);
+
+        if (!bundle.Pending)
+        {
+            bundle.Pending = true;
+            m_pending.push_back(aConnectionId);
+        }
+
+        Write(bundle, apData, aSize);
+    }
+
+    // Sends what the connection has pending
+    template <class T> void Flush(ConnectionId_t aConnectionId, const T& acSend) noexcept
+    {
+        const auto itor = m_bundles.find(aConnectionId);
+        if (itor != std::end(m_bundles))
+            Send(aConnectionId, itor.value(), acSend);
+    }
+
+    // Sends what every connection has pending, once per tick
+    template <class T> void FlushAll(const T& acSend) noexcept
+    {
+        for (const ConnectionId_t cConnectionId : m_pending)
+        {
+            const auto itor = m_bundles.find(cConnectionId);
+            if (itor == std::end(m_bundles))
+                continue;
+
+            itor.value().Pending = false;
+            Send(cConnectionId, itor.value(), acSend);
+        }
+
+        m_pending.clear();
+    }
+
+    // Discards whatever the connection had pending, for connections that went away
+    void Drop(ConnectionId_t aConnectionId) noexcept;
+
+    // Messages that shared a packet with another one since the server started
+    [[nodiscard]] uint64_t GetBundledCount() const noexcept { return m_bundledCount; }
+
+private:
+
+    struct Bundle
+    {
+        bool Pending{false};
+        uint32_t Count{0};
+        // Offset of the first message, right after its size prefix
+        size_t FirstMessage{0};
+        Vector<char> Data;
+    };
+
+    void Write(Bundle& aBundle, const char* apData, size_t aSize) noexcept;
+
+    template <class T> void Send(ConnectionId_t aConnectionId, Bundle& aBundle, const T& acSend) noexcept
+    {
+        if (aBundle.Count == 1)
+        {
+            // A lone message goes out bare, the last byte of its size prefix becomes its packet byte
+            const size_t cStart = aBundle.FirstMessage - 1;
+            acSend(aConnectionId, aBundle.Data.data() + cStart, aBundle.Data.size() - cStart);
+        }
+        else if (aBundle.Count > 1)
+        {
+            acSend(aConnectionId, aBundle.Data.data(), aBundle.Data.size());
+            m_bundledCount += aBundle.Count - 1;
+        }
+
+        // Keep the storage, the same connections get messages every tick
+        aBundle.Data.clear();
+        aBundle.Count = 0;
+    }
+
+    Map<ConnectionId_t, Bundle> m_bundles;
+    Vector<ConnectionId_t> m_pending;
+    uint64_t m_bundledCount{0};
+};
@@ -0,0 +1,90 @@
+#include <Network/SendBuffer.h>
+
+#include <AdminMessages/Message.h>
+#include <Profiling/TickProfiler.h>
+
+#include <base/threading/JobSystem.h>
+
+namespace
+{
+SendBuffer::OpcodeStatistics s_statistics[kServerOpcodeMax];
+}
+
+SendBuffer& SendBuffer::Get() noexcept
+{
+    static thread_local SendBuffer s_buffer;
+    return s_buffer;
+}
+
+std::span<char> SendBuffer::Serialize(const ServerMessage& acServerMessage) noexcept
+{
+    // The profiler is game thread only, job workers serializing in parallel are covered by the service timing
+    std::optional<TickProfiler::Scope> profile;
+    if (!Base::JobSystem::IsWorkerThread())
+        profile.emplace(TickProfiler::Get().GetOutbound(acServerMessage.GetOpcode()));
+
+    const auto cData = SerializeGrowing(acServerMessage);
+    RecordSize(acServerMessage.GetOpcode(), cData.size());
+
+    return cData;
+}
+
+std::span<char> SendBuffer::Serialize(const ServerAdminMessage& acServerMessage) noexcept
+{
+    // Admin messages are rare and mostly large log dumps, don't bother tracking them
+    return SerializeGrowing(acServerMessage);
+}
+
+void SendBuffer::RecordSize(ServerOpcode aOpcode, size_t aSize) noexcept
+{
+    auto& statistics = s_statistics[aOpcode];
+
+    const uint64_t cSize = aSize;
+    statistics.Count.fetch_add(1, std::memory_order_relaxed);
+    statistics.TotalBytes.fetch_add(cSize, std::memory_order_relaxed);
+
+    uint64_t peak = statistics.PeakBytes.load(std::memory_order_relaxed);
+    while (peak < cSize && !statistics.PeakBytes.compare_exchange_weak(peak, cSize, std::memory_order_relaxed))
+    {
+    }
+}
+
+const SendBuffer::OpcodeStatistics& SendBuffer::GetStatistics(ServerOpcode aOpcode) noexcept
+{
+    return s_statistics[aOpcode];
+}
+
+void SendBuffer::ResetStatistics() noexcept
+{
+    for (auto& statistics : s_statistics)
+    {
+        statistics.Count = 0;
+        statistics.TotalBytes = 0;
+        statistics.PeakBytes = 0;
+    }
+}
+
+template <class T> std::span<char> SendBuffer::SerializeGrowing(const T& acMessage) noexcept
+{
+    // A write that doesn't fit is dropped and the writer carries on, a truncated message looks like a short one.
+    // Only trust messages that used at most half of the buffer, serialize the others again in one twice as large.
+    while (true)
+    {
+        Buffer::Writer writer(&m_buffer);
+        writer.WriteBits(0, 8); // Skip the first byte as it is used by packet
+
+        acMessage.Serialize(writer);
+
+        const size_t cSize = writer.Size();
+        if (cSize <= m_buffer.GetSize() / 2)
+            return {reinterpret_cast<char*>(m_buffer.GetWriteData()), cSize};
+
+        if (m_buffer.GetSize() >= 2 * kMaxMessageSize)
+        {
+            spdlog::error("Dropped outgoing message with opcode {}, it doesn't fit in {} bytes", static_cast<uint32_t>(acMessage.GetOpcode()), kMaxMessageSize);
+            return {};
+        }
+
+        m_buffer.Resize(m_buffer.GetSize() * 2);
+    }
+}
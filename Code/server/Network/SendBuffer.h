@@ -0,0 +1,53 @@
+#pragma once
+
+#include <Messages/Message.h>
+
+#include <span>
+
+using TiltedPhoques::Buffer;
+
+struct ServerAdminMessage;
+
+/**
+* @brief Per-thread buffer outgoing messages are serialized in.
+*
+* Serialize hands back a view of the buffer that stays valid until the next call on the same thread, senders copy
+* it where it has to outlive that (a bundle, a shared broadcast, the network queue). The buffer grows with the
+* largest message seen so nothing is truncated below kMaxMessageSize.
+*/
+struct SendBuffer
+{
+    static constexpr size_t kInitialSize = 1 << 16;
+    // Messages that don't fit in this many bytes are logged and dropped
+    static constexpr size_t kMaxMessageSize = 1 << 22;
+
+    struct OpcodeStatistics
+    {
+        std::atomic<uint64_t> Count{0};
+        std::atomic<uint64_t> TotalBytes{0};
+        std::atomic<uint64_t> PeakBytes{0};
+    };
+
+    SendBuffer() noexcept = default;
+    ~SendBuffer() noexcept = default;
+
+    TP_NOCOPYMOVE(SendBuffer);
+
+    static SendBuffer& Get() noexcept;
+
+    // Serializes a game message and records its size in the opcode statistics. The view includes the leading byte
+    // reserved by the packet, it is empty if the message is larger than kMaxMessageSize.
+    std::span<char> Serialize(const ServerMessage& acServerMessage) noexcept;
+    std::span<char> Serialize(const ServerAdminMessage& acServerMessage) noexcept;
+
+    // For messages serialized elsewhere, Serialize records its own
+    static void RecordSize(ServerOpcode aOpcode, size_t aSize) noexcept;
+    [[nodiscard]] static const OpcodeStatistics& GetStatistics(ServerOpcode aOpcode) noexcept;
+    static void ResetStatistics() noexcept;
+
+private:
+
+    template <class T> std::span<char> SerializeGrowing(const T& acMessage) noexcept;
+
+    Buffer m_buffer{kInitialSize};
+};
@@ -0,0 +1,34 @@
+#include <Network/SerializedMessage.h>
+#include <Network/SendBuffer.h>
+
+SerializedMessage::SerializedMessage(const ServerMessage& acServerMessage) noexcept
+    : m_size(0)
+    , m_opcode(acServerMessage.GetOpcode())
+{
+    // Serialize in the thread's send buffer, then keep a tightly sized copy that can outlive it
+    const auto cData = SendBuffer::Get().Serialize(acServerMessage);
+
+    m_size = cData.size();
+    m_buffer.Resize(m_size);
+    std::memcpy(m_buffer.GetWriteData(), cData.data(), m_size);
+}
+
+SerializedMessage::SerializedMessage(ServerOpcode aOpcode, std::span<const char> acData) noexcept
+    : m_size(acData.size())
+    , m_opcode(aOpcode)
+{
+    SendBuffer::RecordSize(aOpcode, m_size);
+
+    m_buffer.Resize(m_size);
+    std::memcpy(m_buffer.GetWriteData(), acData.data(), m_size);
+}
+
+TiltedPhoques::SharedPtr<SerializedMessage> SerializedMessage::Create(const ServerMessage& acServerMessage) noexcept
+{
+    return MakeShared<SerializedMessage>(acServerMessage);
+}
+
+TiltedPhoques::SharedPtr<SerializedMessage> SerializedMessage::Create(ServerOpcode aOpcode, std::span<const char> acData) noexcept
+{
+    return MakeShared<SerializedMessage>(aOpcode, acData);
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <Messages/Message.h>
+
+#include <span>
+
+using TiltedPhoques::Buffer;
+
+/**
+* @brief A server message serialized once, ready to be sent to any number of connections.
+*
+* Broadcasts build one of these and hand the same payload to every recipient instead of
+* serializing the message again for each player.
+*/
+struct SerializedMessage
+{
+    SerializedMessage(const ServerMessage& acServerMessage) noexcept;
+    // Copies a message serialized by the caller, acData includes the leading byte reserved by the packet
+    SerializedMessage(ServerOpcode aOpcode, std::span<const char> acData) noexcept;
+    ~SerializedMessage() noexcept = default;
+
+    TP_NOCOPYMOVE(SerializedMessage);
+
+    static TiltedPhoques::SharedPtr<SerializedMessage> Create(const ServerMessage& acServerMessage) noexcept;
+    static TiltedPhoques::SharedPtr<SerializedMessage> Create(ServerOpcode aOpcode, std::span<const char> acData) noexcept;
+
+    [[nodiscard]] ServerOpcode GetOpcode() const noexcept { return m_opcode; }
+    // Size in bytes, including the leading byte reserved by the packet.
+    [[nodiscard]] size_t GetSize() const noexcept { return m_size; }
+    [[nodiscard]] char* GetData() noexcept { return reinterpret_cast<char*>(m_buffer.GetWriteData()); }
+
+private:
+
+    Buffer m_buffer;
+    size_t m_size;
+    ServerOpcode m_opcode;
+};
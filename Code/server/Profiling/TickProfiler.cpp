@@ -0,0 +1,125 @@
+#include <Profiling/TickProfiler.h>
+
+namespace
+{
+double ToMicroseconds(uint64_t aNanoseconds) noexcept
+{
+    return static_cast<double>(aNanoseconds) / 1000.0;
+}
+
+void DumpTimings(spdlog::logger& aLogger, std::string_view aLabel, const TickProfiler::Timings& acTimings) noexcept
+{
+    aLogger.info("{}: {} calls, mean {:.1f}us, p50 {:.1f}us, p99 {:.1f}us, max {:.1f}us", aLabel, acTimings.GetCount(),
+                 ToMicroseconds(acTimings.GetMean()), ToMicroseconds(acTimings.GetPercentile(50)),
+                 ToMicroseconds(acTimings.GetPercentile(99)), ToMicroseconds(acTimings.GetMax()));
+}
+} // namespace
+
+void TickProfiler::Timings::Record(std::chrono::nanoseconds aDuration) noexcept
+{
+    const uint32_t cNanoseconds = static_cast<uint32_t>(std::min<int64_t>(aDuration.count(), UINT32_MAX));
+
+    ++m_count;
+    m_totalNanoseconds += cNanoseconds;
+    m_maxNanoseconds = std::max(m_maxNanoseconds, cNanoseconds);
+
+    if (m_samples.size() < kSampleWindow)
+    {
+        m_samples.push_back(cNanoseconds);
+        return;
+    }
+
+    m_samples[m_cursor] = cNanoseconds;
+    m_cursor = (m_cursor + 1) % kSampleWindow;
+}
+
+void TickProfiler::Timings::Reset() noexcept
+{
+    m_count = 0;
+    m_totalNanoseconds = 0;
+    m_maxNanoseconds = 0;
+    m_cursor = 0;
+    m_samples.clear();
+}
+
+uint32_t TickProfiler::Timings::GetPercentile(uint32_t aPercentile) const noexcept
+{
+    if (m_samples.empty())
+        return 0;
+
+    Vector<uint32_t> sorted = m_samples;
+    const size_t cIndex = std::min(sorted.size() * aPercentile / 100, sorted.size() - 1);
+    std::nth_element(sorted.begin(), sorted.begin() + cIndex, sorted.end());
+
+    return sorted[cIndex];
+}
+
+TickProfiler& TickProfiler::Get() noexcept
+{
+    static TickProfiler s_profiler;
+    return s_profiler;
+}
+
+TickProfiler::Timings& TickProfiler::GetService(const char* acName) noexcept
+{
+    for (auto& [cpName, pTimings] : m_services)
+    {
+        if (cpName == acName || std::strcmp(cpName, acName) == 0)
+            return *pTimings;
+    }
+
+    return *m_services.emplace_back(acName, MakeUnique<Timings>()).second;
+}
+
+void TickProfiler::Update(uint32_t aIntervalSeconds) noexcept
+{
+    if (aIntervalSeconds == 0)
+        return;
+
+    const auto cNow = std::chrono::steady_clock::now();
+    if (cNow - m_lastDump < std::chrono::seconds(aIntervalSeconds))
+        return;
+
+    m_lastDump = cNow;
+
+    Dump(*spdlog::default_logger());
+    Reset();
+}
+
+void TickProfiler::Dump(spdlog::logger& aLogger) const noexcept
+{
+    if (m_tick.GetCount() != 0)
+        DumpTimings(aLogger, "Tick", m_tick);
+
+    for (const auto& [cpName, pTimings] : m_services)
+    {
+        if (pTimings->GetCount() != 0)
+            DumpTimings(aLogger, cpName, *pTimings);
+    }
+
+    for (uint32_t opcode = 0; opcode < kClientOpcodeMax; ++opcode)
+    {
+        if (m_inbound[opcode].GetCount() != 0)
+            DumpTimings(aLogger, fmt::format("Inbound opcode {}", opcode), m_inbound[opcode]);
+    }
+
+    for (uint32_t opcode = 0; opcode < kServerOpcodeMax; ++opcode)
+    {
+        if (m_outbound[opcode].GetCount() != 0)
+            DumpTimings(aLogger, fmt::format("Outbound opcode {}", opcode), m_outbound[opcode]);
+    }
+}
+
+void TickProfiler::Reset() noexcept
+{
+    m_tick.Reset();
+
+    for (auto& [cpName, pTimings] : m_services)
+        pTimings->Reset();
+
+    for (auto& timings : m_inbound)
+        timings.Reset();
+
+    for (auto& timings : m_outbound)
+        timings.Reset();
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <Messages/Message.h>
+
+namespace spdlog
+{
+class logger;
+}
+
+/**
+* @brief Wall time instrumentation for the game thread.
+*
+* Timings are kept for each UpdateEvent handler (keyed by service name), each inbound opcode handled in OnConsume
+* and each outgoing opcode serialized. Every entry keeps its last kSampleWindow samples to report p50/p99.
+* Only meant to be used from the game thread.
+*/
+struct TickProfiler
+{
+    static constexpr size_t kSampleWindow = 1024;
+
+    struct Timings
+    {
+        void Record(std::chrono::nanoseconds aDuration) noexcept;
+        void Reset() noexcept;
+
+        [[nodiscard]] uint64_t GetCount() const noexcept { return m_count; }
+        // Nanoseconds for the given percentile (0 to 100) over the sample window.
+        [[nodiscard]] uint32_t GetPercentile(uint32_t aPercentile) const noexcept;
+        [[nodiscard]] uint64_t GetMean() const noexcept { return m_count ? m_totalNanoseconds / m_count : 0; }
+        [[nodiscard]] uint32_t GetMax() const noexcept { return m_maxNanoseconds; }
+
+    private:
+        uint64_t m_count{0};
+        uint64_t m_totalNanoseconds{0};
+        uint32_t m_maxNanoseconds{0};
+        size_t m_cursor{0};
+        Vector<uint32_t> m_samples;
+    };
+
+    struct Scope
+    {
+        explicit Scope(Timings& aTimings) noexcept
+            : m_timings(aTimings)
+            , m_start(std::chrono::steady_clock::now())
+        {
+        }
+
+        ~Scope() noexcept
+        {
+            m_timings.Record(std::chrono::steady_clock::now() - m_start);
+        }
+
+        TP_NOCOPYMOVE(Scope);
+
+    private:
+        Timings& m_timings;
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+    TickProfiler() noexcept = default;
+    ~TickProfiler() noexcept = default;
+
+    TP_NOCOPYMOVE(TickProfiler);
+
+    static TickProfiler& Get() noexcept;
+
+    // acName must outlive the profiler, string literals are expected.
+    Timings& GetService(const char* acName) noexcept;
+    Timings& GetInbound(ClientOpcode aOpcode) noexcept { return m_inbound[aOpcode]; }
+    Timings& GetOutbound(ServerOpcode aOpcode) noexcept { return m_outbound[aOpcode]; }
+    Timings& GetTick() noexcept { return m_tick; }
+
+    // Dumps to the log every aIntervalSeconds, 0 disables the periodic dump.
+    void Update(uint32_t aIntervalSeconds) noexcept;
+    void Dump(spdlog::logger& aLogger) const noexcept;
+    void Reset() noexcept;
+
+private:
+    Timings m_tick;
+    Vector<std::pair<const char*, UniquePtr<Timings>>> m_services;
+    Timings m_inbound[kClientOpcodeMax];
+    Timings m_outbound[kServerOpcodeMax];
+    std::chrono::steady_clock::time_point m_lastDump{std::chrono::steady_clock::now()};
+};
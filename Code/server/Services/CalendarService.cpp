@@ -1,6 +1,7 @@
 #include <Services/CalendarService.h>
 
 #include <GameServer.h>
+#include <Profiling/TickProfiler.h>
 #include <World.h>
 
 #include <Events/UpdateEvent.h>
@@ -19,6 +20,8 @@ CalendarService::CalendarService(World &aWorld, entt::dispatcher &aDispatcher) :
 
 void CalendarService::OnUpdate(const UpdateEvent &) noexcept
 {
+    TickProfiler::Scope profile(TickProfiler::Get().GetService("CalendarService"));
+
     if (!m_lastTick)
         m_lastTick = GameServer::Get()->GetTick();
 
@@ -1,6 +1,8 @@
 #include <Services/CharacterService.h>
+#include <Services/NavMeshService.h>
 #include <Components.h>
 #include <GameServer.h>
+#include <Profiling/TickProfiler.h>
 #include <World.h>
 
 #include <Events/CharacterSpawnedEvent.h>
@@ -12,6 +14,10 @@
 #include <Events/OwnershipTransferEvent.h>
 
 #include <Game/OwnerView.h>
+#include <Network/MovementMessageBuilder.h>
+#include <Network/SerializedMessage.h>
+
+#include <base/threading/JobSystem.h>
 
 #include <Messages/AssignCharacterRequest.h>
 #include <Messages/AssignCharacterResponse.h>
@@ -44,6 +50,79 @@
 namespace
 {
 Console::Setting bEnableXpSync{"Gameplay:bEnableXpSync", "Syncs combat XP within the party", true};
+Console::Setting bValidateMovement{"Gameplay:bValidateMovement", "Drops movement updates too far from the nav mesh", false};
+Console::Setting fMaxNavMeshDistance{"Gameplay:fMaxNavMeshDistance", "Distance to the nav mesh tolerated when validating movement", 1024.f};
+Console::Setting bMovementLod{"Gameplay:bMovementLod", "Lowers the movement update rate and detail of distant characters", true};
+Console::Setting uMovementBudget{"Gameplay:uMovementBudget", "Bytes of movement updates sent to a player per snapshot, 0 for no limit", 2048u};
+
+// Replication level of detail of a character for one player, picked from the grid distance between them
+struct MovementLod
+{
+    int32_t MaxDistance;
+    // Movement snapshots per update sent
+    uint32_t Interval;
+    // Animation variables and action events, only worth their bandwidth up close
+    bool Animations;
+};
+
+// Players load 5x5 cells, so only dragons are seen from beyond two cells away
+constexpr MovementLod kMovementLods[] = {
+    {1, 1, true},
+    {2, 3, false},
+    {std::numeric_limits<int32_t>::max(), 6, false},
+};
+
+// Grid distance between a character and a player, party members are followed closely at any distance
+int32_t GetReplicationDistance(Player* apPlayer, const CellIdComponent& acCell, Player* apOwner) noexcept
+{
+    if (acCell.IsInInteriorCell())
+        return 0;
+
+    const auto& partyId = apPlayer->GetParty().JoinedPartyId;
+    if (partyId && apOwner && apOwner->GetParty().JoinedPartyId == partyId)
+        return 0;
+
+    const auto& playerCoords = apPlayer->GetCellComponent().CenterCoords;
+    return std::max(std::abs(acCell.CenterCoords.X - playerCoords.X), std::abs(acCell.CenterCoords.Y - playerCoords.Y));
+}
+
+const MovementLod& GetMovementLod(int32_t aDistance) noexcept
+{
+    if (!bMovementLod)
+        return kMovementLods[0];
+
+    for (const auto& cLod : kMovementLods)
+    {
+        if (aDistance <= cLod.MaxDistance)
+            return cLod;
+    }
+
+    return kMovementLods[std::size(kMovementLods) - 1];
+}
+
+// Added to a character's priority for a player each snapshot its update is due, close characters win the budget
+// first but distant ones catch up the longer they wait. Action events bypass the budget, the boost only sends them
+// first so they are counted before plain movement fills it.
+float GetMovementPriority(int32_t aDistance, bool aHasActions) noexcept
+{
+    return 1.f / static_cast<float>(1 + aDistance) + (aHasActions ? 1.f : 0.f);
+}
+
+// Characters are spread over the snapshots by id so a crowd doesn't update all at once
+bool IsMovementDue(const MovementLod& acLod, uint64_t aSnapshot, uint32_t aServerId) noexcept
+{
+    return (aSnapshot + aServerId) % acLod.Interval == 0;
+}
+
+bool IsOnNavMesh(NavMeshService& aNavMeshService, const CellIdComponent& acLocation, const glm::vec3& acPosition) noexcept
+{
+    // Only places covered by nav meshes can be judged, and jumps or falls leave the mesh for a while
+    if (!aNavMeshService.HasNavMesh(acLocation, acPosition))
+        return true;
+
+    const float tolerance = fMaxNavMeshDistance.value_as<float>();
+    return aNavMeshService.FindNearestPoint(acLocation, acPosition, {tolerance, tolerance, tolerance * 2.f}).has_value();
+}
 }
 
 CharacterService::CharacterService(World& aWorld, entt::dispatcher& aDispatcher) noexcept
@@ -127,6 +206,8 @@ void CharacterService::Serialize(World& aRegistry, entt::entity aEntity, Charact
 
 void CharacterService::OnUpdate(const UpdateEvent&) const noexcept
 {
+    TickProfiler::Scope profile(TickProfiler::Get().GetService("CharacterService"));
+
     ProcessFactionsChanges();
     ProcessMovementChanges();
 }
@@ -148,6 +229,7 @@ void CharacterService::OnCharacterExteriorCellChange(const CharacterExteriorCell
             pPlayer->GetCellComponent().WorldSpaceId == acEvent.WorldSpaceId &&
                 !GridCellCoords::IsCellInGridCell(acEvent.CurrentCoords, pPlayer->GetCellComponent().CenterCoords, false))
         {
+            pPlayer->ForgetCharacter(removeMessage.ServerId);
             pPlayer->Send(removeMessage);
         }
         else if (pPlayer->GetCellComponent().WorldSpaceId == acEvent.WorldSpaceId &&
@@ -172,9 +254,14 @@ void CharacterService::OnCharacterInteriorCellChange(const CharacterInteriorCell
             continue;
 
         if (acEvent.NewCell == pPlayer->GetCellComponent().Cell)
+        {
             pPlayer->Send(spawnMessage);
+        }
         else
+        {
+            pPlayer->ForgetCharacter(removeMessage.ServerId);
             pPlayer->Send(removeMessage);
+        }
     }
 }
 
@@ -192,24 +279,19 @@ void CharacterService::OnAssignCharacterRequest(const PacketEvent<AssignCharacte
         // Look for the character
         auto view = m_world.view<FormIdComponent, ActorValuesComponent, CharacterComponent, MovementComponent, CellIdComponent, OwnerComponent, InventoryComponent>();
 
-        const auto itor = std::find_if(std::begin(view), std::end(view), [view, refId](auto entity)
-            {
-                const auto& formIdComponent = view.get<FormIdComponent>(entity);
+        const auto cEntity = m_world.GetByFormId(refId);
 
-                return formIdComponent.Id == refId;
-            });
-
-        if (itor != std::end(view))
+        if (cEntity != entt::null && view.contains(cEntity))
         {
             // This entity already has an owner
             spdlog::debug("FormId: {:x}:{:x} is already managed", refId.ModId, refId.BaseId);
 
-            auto& actorValuesComponent = view.get<ActorValuesComponent>(*itor);
-            auto& inventoryComponent = view.get<InventoryComponent>(*itor);
-            auto& characterComponent = view.get<CharacterComponent>(*itor);
-            auto& movementComponent = view.get<MovementComponent>(*itor);
-            auto& cellIdComponent = view.get<CellIdComponent>(*itor);
-            auto& ownerComponent = view.get<OwnerComponent>(*itor);
+            auto& actorValuesComponent = view.get<ActorValuesComponent>(cEntity);
+            auto& inventoryComponent = view.get<InventoryComponent>(cEntity);
+            auto& characterComponent = view.get<CharacterComponent>(cEntity);
+            auto& movementComponent = view.get<MovementComponent>(cEntity);
+            auto& cellIdComponent = view.get<CellIdComponent>(cEntity);
+            auto& ownerComponent = view.get<OwnerComponent>(cEntity);
 
             auto& partyService = m_world.GetPartyService();
 
@@ -219,19 +301,19 @@ void CharacterService::OnAssignCharacterRequest(const PacketEvent<AssignCharacte
                 && !characterComponent.IsMount())
             {
                 PartyService::Party* pParty = partyService.GetPlayerParty(acMessage.pPlayer);
-                Player* pOwningPlayer = view.get<OwnerComponent>(*itor).GetOwner();
+                Player* pOwningPlayer = view.get<OwnerComponent>(cEntity).GetOwner();
 
                 // Transfer ownership if owning player is in the same party as the owner
                 if (std::find(pParty->Members.begin(), pParty->Members.end(), pOwningPlayer) != pParty->Members.end())
                 {
-                    TransferOwnership(acMessage.pPlayer, World::ToInteger(*itor));
+                    TransferOwnership(acMessage.pPlayer, World::ToInteger(cEntity));
                     isOwner = true;
                 }
             }
 
             AssignCharacterResponse response{};
             response.Cookie = message.Cookie;
-            response.ServerId = World::ToInteger(*itor);
+            response.ServerId = World::ToInteger(cEntity);
             response.Owner = isOwner;
             response.AllActorValues = actorValuesComponent.CurrentActorValues;
             response.CurrentInventory = inventoryComponent.Content;
@@ -291,7 +373,8 @@ void CharacterService::OnOwnershipTransferRequest(const PacketEvent<RequestOwner
 
         auto& movementComponent = m_world.get<MovementComponent>(cEntity);
         movementComponent.Position = message.Position;
-        movementComponent.Sent = true;
+        // Players are told about the teleport directly, it must not go out again as movement
+        m_world.remove<MovementDirtyComponent>(cEntity);
 
         GameServer::Get()->SendToPlayers(notify, acMessage.pPlayer);
     }
@@ -356,6 +439,8 @@ void CharacterService::OnCharacterRemoveEvent(const CharacterRemoveEvent& acEven
 
     for(auto pPlayer : m_world.GetPlayerManager())
     {
+        pPlayer->ForgetCharacter(acEvent.ServerId);
+
         if (characterOwnerComponent.GetOwner() == pPlayer)
             continue;
 
@@ -442,6 +527,12 @@ void CharacterService::OnReferencesMoveRequest(const PacketEvent<ClientReference
         auto& update = entry.second;
         auto& movement = update.UpdatedMovement;
 
+        if (bValidateMovement && !IsOnNavMesh(m_world.GetNavMeshService(), {movement.CellId, movement.WorldSpaceId, {}}, movement.Position))
+        {
+            spdlog::debug("{:x} moved {:x} off the nav mesh, dropping the update", acMessage.pPlayer->GetConnectionId(), World::ToInteger(*itor));
+            continue;
+        }
+
         movementComponent.Position = movement.Position;
         movementComponent.Rotation = glm::vec3(movement.Rotation.x, 0.f, movement.Rotation.y);
         movementComponent.Variables = movement.Variables;
@@ -461,7 +552,7 @@ void CharacterService::OnReferencesMoveRequest(const PacketEvent<ClientReference
             animationComponent.Actions.push_back(animationComponent.CurrentAction);
         }
 
-        movementComponent.Sent = false;
+        m_world.emplace_or_replace<MovementDirtyComponent>(*itor);
     }
 }
 
@@ -480,7 +571,7 @@ void CharacterService::OnFactionsChanges(const PacketEvent<RequestFactionsChange
 
         auto& characterComponent = view.get<CharacterComponent>(*it);
         characterComponent.FactionsContent = factions;
-        characterComponent.SetDirtyFactions(true);
+        m_world.emplace_or_replace<FactionsDirtyComponent>(*it);
     }
 }
 
@@ -631,7 +722,7 @@ void CharacterService::CreateCharacter(const PacketEvent<AssignCharacterRequest>
     movementComponent.Tick = pServer->GetTick();
     movementComponent.Position = message.Position;
     movementComponent.Rotation = {message.Rotation.x, 0.f, message.Rotation.y};
-    movementComponent.Sent = false;
+    m_world.emplace<MovementDirtyComponent>(cEntity);
 
     auto& animationComponent = m_world.emplace<AnimationComponent>(cEntity);
     animationComponent.CurrentAction = message.LatestAction;
@@ -698,9 +789,11 @@ void CharacterService::ProcessFactionsChanges() const noexcept
 
     lastSendTimePoint = now;
 
-    const auto characterView = m_world.view < CellIdComponent, CharacterComponent, OwnerComponent>();
+    // Only the characters whose factions changed since the last snapshot
+    const auto characterView = m_world.view<FactionsDirtyComponent, CellIdComponent, CharacterComponent, OwnerComponent>();
 
     TiltedPhoques::Map<Player*, NotifyFactionsChanges> messages;
+    const auto& worldMap = m_world.GetPlayerManager().GetWorldMap();
 
     for (auto entity : characterView)
     {
@@ -708,27 +801,19 @@ void CharacterService::ProcessFactionsChanges() const noexcept
         auto& cellIdComponent = characterView.get<CellIdComponent>(entity);
         auto& ownerComponent = characterView.get<OwnerComponent>(entity);
 
-        // If we have nothing new to send skip this
-        if (characterComponent.IsDirtyFactions())
-            continue;
-
-        for (auto pPlayer : m_world.GetPlayerManager())
-        {
+        worldMap.ForEachPlayerInRange(cellIdComponent, characterComponent.IsDragon(), [&](Player* pPlayer) {
             if (pPlayer == ownerComponent.GetOwner())
-                continue;
-
-            if (!cellIdComponent.IsInRange(pPlayer->GetCellComponent(), characterComponent.IsDragon()))
-                continue;
+                return;
 
             auto& message = messages[pPlayer];
             auto& change = message.Changes[World::ToInteger(entity)];
 
             change = characterComponent.FactionsContent;
-        }
-
-        characterComponent.SetDirtyFactions(false);
+        });
     }
 
+    m_world.clear<FactionsDirtyComponent>();
+
     for (auto [pPlayer, message] : messages)
     {
         if (!message.Changes.empty())
@@ -747,54 +832,203 @@ void CharacterService::ProcessMovementChanges() const noexcept
 
     lastSendTimePoint = now;
 
-    const auto characterView = m_world.view<CharacterComponent, CellIdComponent, MovementComponent, AnimationComponent, OwnerComponent>();
+    static uint64_t snapshot = 0;
+    ++snapshot;
 
-    TiltedPhoques::Map<Player*, ServerReferencesMoveRequest> messages;
+    struct MovedCharacter
+    {
+        uint32_t ServerId;
+        const MovementComponent* pMovement;
+        const AnimationComponent* pAnimation;
+    };
 
-    for (auto pPlayer : m_world.GetPlayerManager())
+    struct VisibleCharacter
     {
-        auto& message = messages[pPlayer];
+        uint32_t Index;
+        bool Animations;
+        float Priority;
+    };
+
+    // Only the characters that moved since the last snapshot
+    const auto characterView = m_world.view<MovementDirtyComponent, CharacterComponent, CellIdComponent, MovementComponent, AnimationComponent, OwnerComponent>();
+    const auto& worldMap = m_world.GetPlayerManager().GetWorldMap();
 
-        message.Tick = GameServer::Get()->GetTick();
+    Vector<Player*> players;
+    Map<Player*, uint32_t> playerSlots;
+    for (auto pPlayer : m_world.GetPlayerManager())
+    {
+        playerSlots.emplace(pPlayer, static_cast<uint32_t>(players.size()));
+        players.push_back(pPlayer);
     }
 
+    // Gather who sees what first, the per player messages are then built in parallel without touching the ECS
+    Vector<MovedCharacter> characters;
+    Vector<Vector<VisibleCharacter>> visibleCharacters(players.size());
     for (auto entity : characterView)
     {
-        auto& characterComponent = characterView.get<CharacterComponent>(entity);
-        auto& movementComponent = characterView.get<MovementComponent>(entity);
-        auto& cellIdComponent = characterView.get<CellIdComponent>(entity);
-        auto& ownerComponent = characterView.get<OwnerComponent>(entity);
-        auto& animationComponent = characterView.get<AnimationComponent>(entity);
+        const auto& characterComponent = characterView.get<CharacterComponent>(entity);
+        const auto& cellIdComponent = characterView.get<CellIdComponent>(entity);
+        const auto& ownerComponent = characterView.get<OwnerComponent>(entity);
 
-        // If we have nothing new to send skip this
-        if (movementComponent.Sent == true)
-            continue;
+        const auto cServerId = World::ToInteger(entity);
+        const auto cIndex = static_cast<uint32_t>(characters.size());
+        characters.push_back({cServerId, &characterView.get<MovementComponent>(entity), &characterView.get<AnimationComponent>(entity)});
 
-        for (auto pPlayer : m_world.GetPlayerManager())
-        {
+        worldMap.ForEachPlayerInRange(cellIdComponent, characterComponent.IsDragon(), [&](Player* pPlayer) {
             if (pPlayer == ownerComponent.GetOwner())
-                continue;
+                return;
+
+            const auto itor = playerSlots.find(pPlayer);
+            if (itor == std::end(playerSlots))
+                return;
+
+            // Skipped updates are remembered, the character may stop moving before its next turn
+            const int32_t cDistance = GetReplicationDistance(pPlayer, cellIdComponent, ownerComponent.GetOwner());
+            const auto& lod = GetMovementLod(cDistance);
+            auto& priority = pPlayer->GetPendingMovements().try_emplace(cServerId, 0.f).first.value();
+            if (!IsMovementDue(lod, snapshot, cServerId))
+                return;
+
+            const bool cHasActions = lod.Animations && !characters[cIndex].pAnimation->Actions.empty();
+            priority += GetMovementPriority(cDistance, cHasActions);
+            visibleCharacters[itor->second].push_back({cIndex, lod.Animations, priority});
+        });
+    }
+
+    // Characters that stopped moving while their last movement was held back for a player
+    for (size_t i = 0; i < players.size(); ++i)
+    {
+        Player* pPlayer = players[i];
+        auto& pendingMovements = pPlayer->GetPendingMovements();
 
-            if (!cellIdComponent.IsInRange(pPlayer->GetCellComponent(), characterComponent.IsDragon()))
+        for (auto itor = std::begin(pendingMovements); itor != std::end(pendingMovements);)
+        {
+            const auto cServerId = itor->first;
+            const auto entity = static_cast<entt::entity>(cServerId);
+
+            const bool cValid = m_world.valid(entity) && m_world.all_of<CharacterComponent, CellIdComponent, MovementComponent, AnimationComponent, OwnerComponent>(entity);
+            if (!cValid)
+            {
+                itor = pendingMovements.erase(itor);
                 continue;
+            }
 
-            auto& message = messages[pPlayer];
-            auto& update = message.Updates[World::ToInteger(entity)];
-            auto& movement = update.UpdatedMovement;
+            // Handled with the characters that moved
+            if (m_world.all_of<MovementDirtyComponent>(entity))
+            {
+                ++itor;
+                continue;
+            }
 
-            movement.Position = movementComponent.Position;
+            const auto& cellIdComponent = m_world.get<CellIdComponent>(entity);
+            if (!cellIdComponent.IsInRange(pPlayer->GetCellComponent(), m_world.get<CharacterComponent>(entity).IsDragon()))
+            {
+                itor = pendingMovements.erase(itor);
+                continue;
+            }
 
-            movement.Rotation.x = movementComponent.Rotation.x;
-            movement.Rotation.y = movementComponent.Rotation.z;
+            const int32_t cDistance = GetReplicationDistance(pPlayer, cellIdComponent, m_world.get<OwnerComponent>(entity).GetOwner());
+            const auto& lod = GetMovementLod(cDistance);
+            if (IsMovementDue(lod, snapshot, cServerId))
+            {
+                itor.value() += GetMovementPriority(cDistance, false);
 
-            movement.Direction = movementComponent.Direction;
-            movement.Variables = movementComponent.Variables;
+                visibleCharacters[i].push_back({static_cast<uint32_t>(characters.size()), lod.Animations, itor->second});
+                characters.push_back({cServerId, &m_world.get<MovementComponent>(entity), &m_world.get<AnimationComponent>(entity)});
+            }
 
-            update.ActionEvents = animationComponent.Actions;
+            ++itor;
         }
     }
 
-    m_world.view<AnimationComponent>().each([](AnimationComponent& animationComponent)
+    const auto cTick = GameServer::Get()->GetTick();
+    const size_t cBudget = uMovementBudget.value_as<uint32_t>();
+    Vector<TiltedPhoques::SharedPtr<SerializedMessage>> serializedMessages(players.size());
+
+    // Each job only writes to the baselines and pending movements of its own players
+    Base::JobSystem::Get().ParallelFor(players.size(), 4, [&](size_t aBegin, size_t aEnd) {
+        // Updates are serialized once, in the message itself, and taken back out when over the budget
+        static thread_local MovementMessageBuilder s_builder;
+
+        for (size_t i = aBegin; i < aEnd; ++i)
+        {
+            auto& candidates = visibleCharacters[i];
+            if (candidates.empty())
+                continue;
+
+            std::sort(std::begin(candidates), std::end(candidates),
+                      [](const VisibleCharacter& acLhs, const VisibleCharacter& acRhs) { return acLhs.Priority > acRhs.Priority; });
+
+            s_builder.Begin();
+
+            auto& baselines = players[i]->GetMovementBaselines();
+            auto& pendingMovements = players[i]->GetPendingMovements();
+            size_t spent = 0;
+
+            for (const auto& cVisible : candidates)
+            {
+                const auto& character = characters[cVisible.Index];
+                const auto& movementComponent = *character.pMovement;
+
+                ReferenceUpdate update;
+                auto& movement = update.UpdatedMovement;
+
+                movement.Position = movementComponent.Position;
+
+                movement.Rotation.x = movementComponent.Rotation.x;
+                movement.Rotation.y = movementComponent.Rotation.z;
+
+                movement.Direction = movementComponent.Direction;
+                movement.Variables = movementComponent.Variables;
+
+                if (cVisible.Animations)
+                    update.ActionEvents = character.pAnimation->Actions;
+
+                // The connection is reliable and ordered, so the last movement sent is the one the client will hold
+                // when this update arrives, only send what changed since then
+                const auto baseline = baselines.find(character.ServerId);
+                if (baseline != std::end(baselines))
+                {
+                    // Held at what the client has, the changes go out once the character is close again
+                    if (!cVisible.Animations)
+                        movement.Variables = baseline->second.Variables;
+
+                    update.MakeDelta(baseline->second);
+                }
+
+                const bool cHasActions = !update.ActionEvents.empty();
+                const size_t cSize = s_builder.Append(character.ServerId, std::move(update));
+
+                if (cBudget)
+                {
+                    // The first update always goes out so a single large one can't stall the player, what doesn't
+                    // fit stays pending with its priority and competes again on its next turn. Action events are
+                    // cleared once the snapshot is done and can't wait, they always go out.
+                    if (spent > 0 && spent + cSize > cBudget && !cHasActions)
+                    {
+                        s_builder.Rollback();
+                        continue;
+                    }
+
+                    spent += cSize;
+                }
+
+                const auto& cSent = s_builder.GetLast().UpdatedMovement;
+                if (baseline != std::end(baselines))
+                    baseline.value() = cSent;
+                else
+                    baselines.emplace(character.ServerId, cSent);
+
+                pendingMovements.erase(character.ServerId);
+            }
+
+            if (!s_builder.IsEmpty())
+                serializedMessages[i] = SerializedMessage::Create(ServerReferencesMoveRequest::Opcode, s_builder.Finish(cTick));
+        }
+    });
+
+    // Actions are only queued by movement requests, which also mark the character dirty
+    m_world.view<MovementDirtyComponent, AnimationComponent>().each([](AnimationComponent& animationComponent)
     {
         if (!animationComponent.Actions.empty())
             animationComponent.LastSerializedAction = animationComponent.Actions[animationComponent.Actions.size() - 1];
@@ -802,15 +1036,12 @@ void CharacterService::ProcessMovementChanges() const noexcept
         animationComponent.Actions.clear();
     });
 
-    m_world.view<MovementComponent>().each([](MovementComponent& movementComponent)
-    {
-        movementComponent.Sent = true;
-    });
+    m_world.clear<MovementDirtyComponent>();
 
-    for (auto& [pPlayer, message] : messages)
+    for (size_t i = 0; i < players.size(); ++i)
     {
-        if (!message.Updates.empty())
-            pPlayer->Send(message);
+        if (serializedMessages[i])
+            GameServer::Get()->Send(players[i]->GetConnectionId(), serializedMessages[i]);
     }
 }
 
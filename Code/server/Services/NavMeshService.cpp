@@ -0,0 +1,656 @@
+#include <Services/NavMeshService.h>
+
+#include <Components.h>
+#include <World.h>
+
+#include <es_loader/ESLoader.h>
+
+#include <DetourCommon.h>
+#include <DetourNavMesh.h>
+#include <DetourNavMeshBuilder.h>
+#include <DetourNavMeshQuery.h>
+
+#include <cfloat>
+
+namespace
+{
+Console::Setting uTileBudget{"NavMesh:uTileBudget", "Maximum number of nav mesh tiles kept in memory per world space", 256u};
+
+// Exterior cells are 4096 units wide, each one becomes a tile
+constexpr float kCellSize = 4096.f;
+// Vertices are quantized to whole units, less than 1.5cm in game
+constexpr float kVoxelSize = 1.f;
+// Detour stores vertex and polygon indices on 16 bits
+constexpr uint32_t kMaxTileVertices = 0xFFFE;
+constexpr uint32_t kMaxTilePolys = 0xFFFE;
+// Polygon index bits left at least to every tile, whatever the tile budget
+constexpr uint32_t kMinPolyBits = 12;
+constexpr uint16_t kNullIndex = 0xFFFF;
+constexpr uint16_t kPortalFlag = 0x8000;
+constexpr uint16_t kWalkableFlag = 0x1;
+// Edges this close to a cell border are considered on it
+constexpr float kPortalTolerance = 1.f;
+constexpr int kMaxSearchNodes = 4096;
+constexpr int kMaxPathPolys = 512;
+constexpr int kMaxPathPoints = 256;
+
+// Game space is z up, Detour is y up
+glm::vec3 ToDetour(const glm::vec3& acPosition) noexcept
+{
+    return {acPosition.x, acPosition.z, -acPosition.y};
+}
+
+glm::vec3 ToGame(const float* acpPosition) noexcept
+{
+    return {acpPosition[0], -acpPosition[2], acpPosition[1]};
+}
+
+uint64_t MakeTileKey(int32_t aX, int32_t aY) noexcept
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(aX)) << 32) | static_cast<uint32_t>(aY);
+}
+
+void SplitTileKey(uint64_t aKey, int32_t& aX, int32_t& aY) noexcept
+{
+    aX = static_cast<int32_t>(aKey >> 32);
+    aY = static_cast<int32_t>(aKey & 0xFFFFFFFF);
+}
+
+uint32_t ToBits(uint32_t aValue) noexcept
+{
+    return dtIlog2(dtNextPow2(std::max(aValue, 1u)));
+}
+
+// Portal side of an edge lying on the tile bounds, as expected by dtCreateNavMeshData
+uint16_t GetPortal(const glm::vec3& acA, const glm::vec3& acB, const glm::vec3& acTileMin, const glm::vec3& acTileMax) noexcept
+{
+    auto isOn = [](float aA, float aB, float aBorder) {
+        return std::abs(aA - aBorder) <= kPortalTolerance && std::abs(aB - aBorder) <= kPortalTolerance;
+    };
+
+    if (isOn(acA.x, acB.x, acTileMin.x))
+        return kPortalFlag | 0;
+    if (isOn(acA.z, acB.z, acTileMax.z))
+        return kPortalFlag | 1;
+    if (isOn(acA.x, acB.x, acTileMax.x))
+        return kPortalFlag | 2;
+    if (isOn(acA.z, acB.z, acTileMin.z))
+        return kPortalFlag | 3;
+
+    return kNullIndex;
+}
+
+// Merges the nav meshes of a tile into Detour tile data, null on failure
+uint8_t* BuildTileData(const Vector<NAVM>& acNavMeshes, int32_t aTileX, int32_t aTileY, bool aExterior, uint32_t aMaxPolys,
+                       int& aDataSize) noexcept
+{
+    struct PolyRange
+    {
+        uint32_t First;
+        uint32_t Count;
+    };
+
+    Map<uint32_t, PolyRange> polyRanges;
+    Vector<glm::vec3> positions;
+    uint32_t polyCount = 0;
+
+    for (const NAVM& record : acNavMeshes)
+    {
+        const auto& navMesh = record.m_navMesh;
+        if (navMesh.m_vertices.empty())
+            continue;
+
+        if (positions.size() + navMesh.m_vertices.size() > kMaxTileVertices || polyCount + navMesh.m_triangles.size() > aMaxPolys)
+        {
+            spdlog::warn("Nav mesh tile {}, {} is too large, skipping nav mesh {:X}", aTileX, aTileY, record.GetFormId());
+            continue;
+        }
+
+        polyRanges[record.GetFormId()] = {polyCount, static_cast<uint32_t>(navMesh.m_triangles.size())};
+        polyCount += static_cast<uint32_t>(navMesh.m_triangles.size());
+
+        for (const auto& vertex : navMesh.m_vertices)
+            positions.push_back(ToDetour(vertex));
+    }
+
+    if (polyCount == 0)
+        return nullptr;
+
+    glm::vec3 min = positions[0];
+    glm::vec3 max = positions[0];
+    for (const auto& position : positions)
+    {
+        min = glm::min(min, position);
+        max = glm::max(max, position);
+    }
+
+    // Border edges must land on the exact cell bounds once quantized, on both sides of the border
+    const glm::vec3 tileMin{aTileX * kCellSize, min.y, aTileY * kCellSize};
+    const glm::vec3 tileMax{(aTileX + 1) * kCellSize, max.y, (aTileY + 1) * kCellSize};
+    if (aExterior)
+    {
+        min = glm::min(min, tileMin);
+        max = glm::max(max, tileMax);
+    }
+
+    min = glm::floor(min);
+    max = glm::ceil(max);
+
+    const glm::vec3 extent = (max - min) / kVoxelSize;
+    if (extent.x > kMaxTileVertices || extent.y > kMaxTileVertices || extent.z > kMaxTileVertices)
+    {
+        spdlog::warn("Nav mesh tile {}, {} spans more than {} units, skipping it", aTileX, aTileY, kMaxTileVertices);
+        return nullptr;
+    }
+
+    Vector<uint16_t> vertices(positions.size() * 3);
+    for (size_t i = 0; i < positions.size(); ++i)
+    {
+        const glm::vec3 quantized = glm::round((positions[i] - min) / kVoxelSize);
+        vertices[i * 3 + 0] = static_cast<uint16_t>(quantized.x);
+        vertices[i * 3 + 1] = static_cast<uint16_t>(quantized.y);
+        vertices[i * 3 + 2] = static_cast<uint16_t>(quantized.z);
+    }
+
+    // Each polygon is a triangle followed by its three neighbours
+    Vector<uint16_t> polys(polyCount * 6, kNullIndex);
+    Vector<uint16_t> polyFlags(polyCount, kWalkableFlag);
+    Vector<uint8_t> polyAreas(polyCount, 0);
+
+    uint32_t firstVertex = 0;
+    for (const NAVM& record : acNavMeshes)
+    {
+        const auto range = polyRanges.find(record.GetFormId());
+        if (range == std::end(polyRanges))
+            continue;
+
+        const auto& navMesh = record.m_navMesh;
+        const auto triangleCount = static_cast<int32_t>(navMesh.m_triangles.size());
+
+        for (int32_t i = 0; i < triangleCount; ++i)
+        {
+            const auto& triangle = navMesh.m_triangles[i];
+            const int16_t triangleVertices[3] = {triangle.m_vertex0, triangle.m_vertex1, triangle.m_vertex2};
+            const int16_t triangleEdges[3] = {triangle.m_edge0, triangle.m_edge1, triangle.m_edge2};
+
+            uint16_t indices[3];
+            uint16_t neighbours[3];
+            bool valid = true;
+
+            for (int edge = 0; edge < 3; ++edge)
+            {
+                const int16_t vertex = triangleVertices[edge];
+                valid &= vertex >= 0 && vertex < static_cast<int32_t>(navMesh.m_vertices.size());
+                indices[edge] = static_cast<uint16_t>(firstVertex + vertex);
+            }
+
+            // Keep the slot so polygon indices stay aligned, but leave it degenerate and unusable by the filters
+            if (!valid)
+            {
+                uint16_t* pPoly = &polys[(range->second.First + i) * 6];
+                std::fill(pPoly, pPoly + 3, static_cast<uint16_t>(firstVertex));
+                polyFlags[range->second.First + i] = 0;
+                continue;
+            }
+
+            for (int edge = 0; edge < 3; ++edge)
+            {
+                const int16_t link = triangleEdges[edge];
+                neighbours[edge] = kNullIndex;
+
+                if (link < 0)
+                    continue;
+
+                if ((triangle.m_coverMarker & Chunks::NVNM::Tri::kEdgeLinkFlags[edge]) == 0)
+                {
+                    if (link < triangleCount)
+                        neighbours[edge] = static_cast<uint16_t>(range->second.First + link);
+                    continue;
+                }
+
+                if (link >= static_cast<int32_t>(navMesh.m_connections.size()))
+                    continue;
+
+                // Links to nav meshes merged in this tile are plain neighbours, the others can only be followed
+                // through the cell borders
+                const auto& connection = navMesh.m_connections[link];
+                const auto target = polyRanges.find(connection.m_navMeshId);
+                if (target != std::end(polyRanges))
+                {
+                    if (connection.tri >= 0 && static_cast<uint32_t>(connection.tri) < target->second.Count)
+                        neighbours[edge] = static_cast<uint16_t>(target->second.First + connection.tri);
+                }
+                else if (aExterior)
+                    neighbours[edge] = GetPortal(positions[indices[edge]], positions[indices[(edge + 1) % 3]], tileMin, tileMax);
+            }
+
+            // Detour expects a winding where the 2D area is positive, swapping two vertices also swaps the edges
+            // that touch them
+            if (dtTriArea2D(&positions[indices[0]].x, &positions[indices[1]].x, &positions[indices[2]].x) < 0.f)
+            {
+                std::swap(indices[1], indices[2]);
+                std::swap(neighbours[0], neighbours[2]);
+            }
+
+            uint16_t* pPoly = &polys[(range->second.First + i) * 6];
+            std::copy(std::begin(indices), std::end(indices), pPoly);
+            std::copy(std::begin(neighbours), std::end(neighbours), pPoly + 3);
+        }
+
+        firstVertex += static_cast<uint32_t>(navMesh.m_vertices.size());
+    }
+
+    dtNavMeshCreateParams params{};
+    params.verts = vertices.data();
+    params.vertCount = static_cast<int>(positions.size());
+    params.polys = polys.data();
+    params.polyFlags = polyFlags.data();
+    params.polyAreas = polyAreas.data();
+    params.polyCount = static_cast<int>(polyCount);
+    params.nvp = 3;
+    params.tileX = aTileX;
+    params.tileY = aTileY;
+    params.walkableHeight = 128.f;
+    params.walkableRadius = 32.f;
+    params.walkableClimb = 64.f;
+    params.cs = kVoxelSize;
+    params.ch = kVoxelSize;
+    params.buildBvTree = true;
+    dtVcopy(params.bmin, &min.x);
+    dtVcopy(params.bmax, &max.x);
+
+    uint8_t* pData = nullptr;
+    if (!dtCreateNavMeshData(&params, &pData, &aDataSize))
+    {
+        spdlog::warn("Failed to create nav mesh tile {}, {}", aTileX, aTileY);
+        return nullptr;
+    }
+
+    return pData;
+}
+} // namespace
+
+NavMeshService::Space::~Space() noexcept
+{
+    dtFreeNavMeshQuery(pQuery);
+    dtFreeNavMesh(pNavMesh);
+}
+
+NavMeshService::NavMeshService(World& aWorld, entt::dispatcher& aDispatcher) noexcept
+    : m_world(aWorld)
+{
+}
+
+NavMeshService::~NavMeshService() noexcept = default;
+
+bool NavMeshService::HasNavMesh(const CellIdComponent& acLocation, const glm::vec3& acPosition) noexcept
+{
+    const Space* pSpace = GetSpace(acLocation);
+    if (!pSpace)
+        return false;
+
+    if (!pSpace->Exterior)
+        return true;
+
+    const glm::vec3 position = ToDetour(acPosition);
+    const auto x = static_cast<int32_t>(std::floor(position.x / kCellSize));
+    const auto y = static_cast<int32_t>(std::floor(position.z / kCellSize));
+
+    return pSpace->Tiles.find(MakeTileKey(x, y)) != std::end(pSpace->Tiles);
+}
+
+std::optional<glm::vec3> NavMeshService::FindNearestPoint(const CellIdComponent& acLocation, const glm::vec3& acPosition,
+                                                          const glm::vec3& acExtents) noexcept
+{
+    Space* pSpace = GetSpace(acLocation);
+    if (!pSpace)
+        return std::nullopt;
+
+    const glm::vec3 center = ToDetour(acPosition);
+    const glm::vec3 extents = glm::abs(ToDetour(acExtents));
+
+    ++m_queryCount;
+    if (!LoadTiles(*pSpace, center - extents, center + extents))
+        return std::nullopt;
+
+    const dtQueryFilter filter;
+    dtPolyRef ref = 0;
+    float nearest[3];
+    if (dtStatusFailed(pSpace->pQuery->findNearestPoly(&center.x, &extents.x, &filter, &ref, nearest)) || !ref)
+        return std::nullopt;
+
+    return ToGame(nearest);
+}
+
+std::optional<glm::vec3> NavMeshService::Raycast(const CellIdComponent& acLocation, const glm::vec3& acStart, const glm::vec3& acEnd) noexcept
+{
+    Space* pSpace = GetSpace(acLocation);
+    if (!pSpace)
+        return std::nullopt;
+
+    const glm::vec3 start = ToDetour(acStart);
+    const glm::vec3 end = ToDetour(acEnd);
+    const glm::vec3 extents = ToDetour(kDefaultExtents);
+
+    ++m_queryCount;
+    if (!LoadTiles(*pSpace, glm::min(start, end) - extents, glm::max(start, end) + extents))
+        return std::nullopt;
+
+    const dtQueryFilter filter;
+    dtPolyRef startRef = 0;
+    float startPosition[3];
+    if (dtStatusFailed(pSpace->pQuery->findNearestPoly(&start.x, &extents.x, &filter, &startRef, startPosition)) || !startRef)
+        return std::nullopt;
+
+    float hitTime = 0.f;
+    float hitNormal[3];
+    if (dtStatusFailed(pSpace->pQuery->raycast(startRef, startPosition, &end.x, &filter, &hitTime, hitNormal, nullptr, nullptr, 0)))
+        return std::nullopt;
+
+    // The ray reached the end without leaving the mesh
+    if (hitTime == FLT_MAX)
+        return acEnd;
+
+    float hit[3];
+    dtVlerp(hit, startPosition, &end.x, hitTime);
+    return ToGame(hit);
+}
+
+bool NavMeshService::FindPath(const CellIdComponent& acLocation, const glm::vec3& acStart, const glm::vec3& acEnd,
+                              Vector<glm::vec3>& aPath) noexcept
+{
+    aPath.clear();
+
+    Space* pSpace = GetSpace(acLocation);
+    if (!pSpace)
+        return false;
+
+    const glm::vec3 start = ToDetour(acStart);
+    const glm::vec3 end = ToDetour(acEnd);
+    const glm::vec3 extents = ToDetour(kDefaultExtents);
+    const glm::vec3 margin{pSpace->TileSize, 0.f, pSpace->TileSize};
+
+    ++m_queryCount;
+    if (!LoadTiles(*pSpace, glm::min(start, end) - extents - margin, glm::max(start, end) + extents + margin))
+        return false;
+
+    const dtQueryFilter filter;
+    dtPolyRef startRef = 0;
+    dtPolyRef endRef = 0;
+    float startPosition[3];
+    float endPosition[3];
+    pSpace->pQuery->findNearestPoly(&start.x, &extents.x, &filter, &startRef, startPosition);
+    pSpace->pQuery->findNearestPoly(&end.x, &extents.x, &filter, &endRef, endPosition);
+    if (!startRef || !endRef)
+        return false;
+
+    dtPolyRef polys[kMaxPathPolys];
+    int polyCount = 0;
+    const dtStatus status = pSpace->pQuery->findPath(startRef, endRef, startPosition, endPosition, &filter, polys, &polyCount, kMaxPathPolys);
+    if (dtStatusFailed(status) || polyCount == 0)
+        return false;
+
+    // Partial paths stop on the polygon closest to the goal
+    if (polys[polyCount - 1] != endRef)
+        pSpace->pQuery->closestPointOnPoly(polys[polyCount - 1], endPosition, endPosition, nullptr);
+
+    float points[kMaxPathPoints * 3];
+    int pointCount = 0;
+    if (dtStatusFailed(pSpace->pQuery->findStraightPath(startPosition, endPosition, polys, polyCount, points, nullptr, nullptr,
+                                                        &pointCount, kMaxPathPoints)))
+        return false;
+
+    aPath.reserve(pointCount);
+    for (int i = 0; i < pointCount; ++i)
+        aPath.push_back(ToGame(&points[i * 3]));
+
+    return polys[polyCount - 1] == endRef && !dtStatusDetail(status, DT_PARTIAL_RESULT);
+}
+
+NavMeshService::Space* NavMeshService::GetSpace(const CellIdComponent& acLocation) noexcept
+{
+    if (!m_world.GetRecordCollection())
+        return nullptr;
+
+    const bool exterior = !acLocation.IsInInteriorCell();
+    const uint32_t parentId = m_world.ctx().at<ModsComponent>().GetServerFormId(exterior ? acLocation.WorldSpaceId : acLocation.Cell);
+    if (!parentId)
+        return nullptr;
+
+    auto itor = m_spaces.find(parentId);
+    if (itor == std::end(m_spaces))
+        itor = m_spaces.emplace(parentId, BuildSpace(parentId, exterior)).first;
+
+    return itor->second.get();
+}
+
+UniquePtr<NavMeshService::Space> NavMeshService::BuildSpace(uint32_t aParentId, bool aExterior) noexcept
+{
+    IndexNavMeshes();
+
+    const auto navMeshIds = m_navMeshesByParent.find(aParentId);
+    if (navMeshIds == std::end(m_navMeshesByParent))
+        return nullptr;
+
+    auto pSpace = MakeUnique<Space>();
+    pSpace->Exterior = aExterior;
+
+    pSpace->MinTileX = pSpace->MinTileY = INT32_MAX;
+    pSpace->MaxTileX = pSpace->MaxTileY = INT32_MIN;
+    for (const auto& navMesh : navMeshIds->second)
+    {
+        pSpace->Tiles[navMesh.TileKey].NavMeshIds.push_back(navMesh.FormId);
+
+        int32_t x = 0;
+        int32_t y = 0;
+        SplitTileKey(navMesh.TileKey, x, y);
+
+        pSpace->MinTileX = std::min(pSpace->MinTileX, x);
+        pSpace->MinTileY = std::min(pSpace->MinTileY, y);
+        pSpace->MaxTileX = std::max(pSpace->MaxTileX, x);
+        pSpace->MaxTileY = std::max(pSpace->MaxTileY, y);
+    }
+
+    if (aExterior)
+    {
+        pSpace->Origin = glm::vec3{0.f};
+        pSpace->TileSize = kCellSize;
+    }
+    else
+    {
+        // Interiors are a single tile covering the whole cell, anchored on its lowest corner like its tile data. The
+        // bounds need the vertices, the few nav meshes of a cell are parsed again when the tile is built.
+        auto* pRecords = m_world.GetRecordCollection();
+        glm::vec3 min{FLT_MAX};
+        glm::vec3 max{-FLT_MAX};
+
+        for (const auto& navMesh : navMeshIds->second)
+        {
+            NAVM record;
+            if (!pRecords->ParseNavMeshById(navMesh.FormId, record))
+                continue;
+
+            for (const auto& vertex : record.m_navMesh.m_vertices)
+            {
+                min = glm::min(min, ToDetour(vertex));
+                max = glm::max(max, ToDetour(vertex));
+            }
+        }
+
+        if (min.x > max.x)
+            return nullptr;
+
+        pSpace->Origin = glm::floor(min);
+        pSpace->TileSize = std::max(1.f, glm::ceil(std::max(max.x - pSpace->Origin.x, max.z - pSpace->Origin.z)) + 1.f);
+    }
+
+    // Poly refs pack the tile and polygon indices with a salt in 32 bits, the salt needs at least 10 of them. Polygon
+    // counts are only known once tiles are built, tiles get whatever the resident tile count leaves.
+    const uint32_t tileBits = std::min(ToBits(std::min<uint32_t>(static_cast<uint32_t>(pSpace->Tiles.size()), uTileBudget.value_as<uint32_t>())),
+                                       22u - kMinPolyBits);
+    const uint32_t polyBits = std::min(22u - tileBits, ToBits(kMaxTilePolys));
+
+    dtNavMeshParams params{};
+    dtVcopy(params.orig, &pSpace->Origin.x);
+    params.tileWidth = pSpace->TileSize;
+    params.tileHeight = pSpace->TileSize;
+    params.maxTiles = 1 << tileBits;
+    params.maxPolys = 1 << polyBits;
+    pSpace->MaxTilePolys = std::min<uint32_t>(params.maxPolys, kMaxTilePolys);
+
+    pSpace->pNavMesh = dtAllocNavMesh();
+    pSpace->pQuery = dtAllocNavMeshQuery();
+    if (!pSpace->pNavMesh || !pSpace->pQuery || dtStatusFailed(pSpace->pNavMesh->init(&params)) ||
+        dtStatusFailed(pSpace->pQuery->init(pSpace->pNavMesh, kMaxSearchNodes)))
+    {
+        spdlog::error("Failed to create the nav mesh of {:X}", aParentId);
+        return nullptr;
+    }
+
+    spdlog::info("Nav mesh of {:X}: {} nav meshes in {} tiles, {} resident at most", aParentId, navMeshIds->second.size(), pSpace->Tiles.size(),
+                 params.maxTiles);
+
+    return pSpace;
+}
+
+void NavMeshService::IndexNavMeshes() noexcept
+{
+    if (m_indexed)
+        return;
+
+    m_indexed = true;
+
+    auto* pRecords = m_world.GetRecordCollection();
+    const auto navMeshIds = pRecords->GetFormIdsOfType(FormEnum::NAVM);
+
+    for (uint32_t formId : navMeshIds)
+    {
+        NAVM::Location location{};
+        if (!pRecords->GetNavMeshLocation(formId, location))
+        {
+            spdlog::warn("Failed to read the location of nav mesh {:X}", formId);
+            continue;
+        }
+
+        // Detour's tile rows grow along +z, which is -y in game space
+        if (location.m_worldSpaceId)
+            m_navMeshesByParent[location.m_worldSpaceId].push_back({formId, MakeTileKey(location.m_gridX, -location.m_gridY - 1)});
+        else if (location.m_cellId)
+            m_navMeshesByParent[location.m_cellId].push_back({formId, MakeTileKey(0, 0)});
+    }
+
+    spdlog::info("Indexed {} nav meshes in {} locations", navMeshIds.size(), m_navMeshesByParent.size());
+}
+
+bool NavMeshService::LoadTiles(Space& aSpace, const glm::vec3& acMin, const glm::vec3& acMax) noexcept
+{
+    // Boxes far outside of the space would overflow the tile coordinates, clamp in floating point first
+    auto toTile = [&aSpace](float aPosition, float aOrigin, int32_t aMin, int32_t aMax) {
+        const float tile = std::floor((aPosition - aOrigin) / aSpace.TileSize);
+        return static_cast<int32_t>(std::clamp(tile, static_cast<float>(aMin) - 1.f, static_cast<float>(aMax) + 1.f));
+    };
+
+    const int32_t minX = std::max(toTile(acMin.x, aSpace.Origin.x, aSpace.MinTileX, aSpace.MaxTileX), aSpace.MinTileX);
+    const int32_t minY = std::max(toTile(acMin.z, aSpace.Origin.z, aSpace.MinTileY, aSpace.MaxTileY), aSpace.MinTileY);
+    const int32_t maxX = std::min(toTile(acMax.x, aSpace.Origin.x, aSpace.MinTileX, aSpace.MaxTileX), aSpace.MaxTileX);
+    const int32_t maxY = std::min(toTile(acMax.z, aSpace.Origin.z, aSpace.MinTileY, aSpace.MaxTileY), aSpace.MaxTileY);
+
+    // Only the tiles holding nav meshes take a slot, empty cells in the box are free
+    Vector<std::pair<uint64_t, Tile*>> tiles;
+    for (int32_t y = minY; y <= maxY; ++y)
+    {
+        for (int32_t x = minX; x <= maxX; ++x)
+        {
+            const uint64_t key = MakeTileKey(x, y);
+            auto itor = aSpace.Tiles.find(key);
+            if (itor != std::end(aSpace.Tiles))
+                tiles.emplace_back(key, &itor.value());
+        }
+    }
+
+    const auto maxTiles = static_cast<size_t>(aSpace.pNavMesh->getMaxTiles());
+    if (tiles.size() > maxTiles)
+    {
+        spdlog::debug("Nav mesh query spans {} tiles, more than the budget of {}", tiles.size(), maxTiles);
+        return false;
+    }
+
+    // Resident tiles of this query move to the front before anything is loaded, so making room for the others only
+    // ever evicts tiles the query doesn't use
+    for (auto& [key, pTile] : tiles)
+    {
+        pTile->LastQuery = m_queryCount;
+        if (pTile->Ref)
+            aSpace.Lru.splice(std::begin(aSpace.Lru), aSpace.Lru, pTile->LruEntry);
+    }
+
+    bool loaded = true;
+    for (auto& [key, pTile] : tiles)
+    {
+        if (pTile->Ref || pTile->Empty)
+            continue;
+
+        if (!LoadTile(aSpace, key, *pTile))
+        {
+            spdlog::debug("Failed to load nav mesh tile {:X} for a query", key);
+            loaded = false;
+        }
+    }
+
+    return loaded;
+}
+
+bool NavMeshService::LoadTile(Space& aSpace, uint64_t aKey, Tile& aTile) noexcept
+{
+    // Parsed for this build only, the tile data keeps everything queries need
+    auto* pRecords = m_world.GetRecordCollection();
+    Vector<NAVM> navMeshes(aTile.NavMeshIds.size());
+    bool empty = true;
+    for (size_t i = 0; i < aTile.NavMeshIds.size(); ++i)
+    {
+        pRecords->ParseNavMeshById(aTile.NavMeshIds[i], navMeshes[i]);
+        empty &= navMeshes[i].m_navMesh.m_triangles.empty();
+    }
+
+    // Nothing to walk on, not a failure and not worth a slot
+    if (empty)
+    {
+        aTile.Empty = true;
+        return true;
+    }
+
+    // LoadTiles moved the resident tiles of the current query to the front, the span check guarantees the back
+    // holds others to evict
+    while (!aSpace.Lru.empty() && aSpace.Lru.size() >= static_cast<size_t>(aSpace.pNavMesh->getMaxTiles()))
+    {
+        Tile& evicted = aSpace.Tiles[aSpace.Lru.back()];
+        if (evicted.LastQuery == m_queryCount)
+            return false;
+
+        aSpace.pNavMesh->removeTile(evicted.Ref, nullptr, nullptr);
+        evicted.Ref = 0;
+        aSpace.Lru.pop_back();
+    }
+
+    int32_t x = 0;
+    int32_t y = 0;
+    SplitTileKey(aKey, x, y);
+
+    int dataSize = 0;
+    uint8_t* pData = BuildTileData(navMeshes, x, y, aSpace.Exterior, aSpace.MaxTilePolys, dataSize);
+    if (!pData)
+        return false;
+
+    dtTileRef ref = 0;
+    if (dtStatusFailed(aSpace.pNavMesh->addTile(pData, dataSize, DT_TILE_FREE_DATA, 0, &ref)))
+    {
+        dtFree(pData);
+        return false;
+    }
+
+    aTile.Ref = ref;
+    aSpace.Lru.push_front(aKey);
+    aTile.LruEntry = std::begin(aSpace.Lru);
+
+    return true;
+}
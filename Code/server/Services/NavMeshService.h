@@ -0,0 +1,95 @@
+#pragma once
+
+#include <list>
+
+struct World;
+struct CellIdComponent;
+class NAVM;
+class dtNavMesh;
+class dtNavMeshQuery;
+
+/**
+* @brief Walkability queries against the game's nav meshes.
+*
+* NAVM records are converted to Detour tiles the first time a query touches them: one tile per exterior cell,
+* one tile per interior cell. Nav meshes of the same tile are merged so their edge links become regular
+* neighbours, links across exterior cell borders become tile portals. Only a bounded number of tiles is kept,
+* the least recently used ones are dropped first. Nav meshes are located from their record header alone and only
+* parsed while their tile is built, the parsed records are not kept.
+*
+* Positions are in game space (z up). A location is a world space, or the interior cell when it has none.
+*/
+struct NavMeshService
+{
+    NavMeshService(World& aWorld, entt::dispatcher& aDispatcher) noexcept;
+    ~NavMeshService() noexcept;
+
+    TP_NOCOPYMOVE(NavMeshService);
+
+    // Half size of the box searched around a position, tall enough to catch stairs and slopes
+    inline static const glm::vec3 kDefaultExtents{256.f, 256.f, 512.f};
+
+    // Whether nav mesh data exists where the position is, queries can only fail meaningfully there
+    [[nodiscard]] bool HasNavMesh(const CellIdComponent& acLocation, const glm::vec3& acPosition) noexcept;
+    // Closest point on the nav mesh within acExtents of acPosition
+    [[nodiscard]] std::optional<glm::vec3> FindNearestPoint(const CellIdComponent& acLocation, const glm::vec3& acPosition,
+                                                            const glm::vec3& acExtents = kDefaultExtents) noexcept;
+    // Walks the nav mesh surface from acStart toward acEnd, returns where the walk stops (acEnd if nothing blocks it)
+    [[nodiscard]] std::optional<glm::vec3> Raycast(const CellIdComponent& acLocation, const glm::vec3& acStart, const glm::vec3& acEnd) noexcept;
+    // Corners of the path from acStart to acEnd. Paths are only searched within the tiles spanned by the end points
+    // and their neighbours, returns false if acEnd can't be reached in there, aPath then ends at the closest point.
+    bool FindPath(const CellIdComponent& acLocation, const glm::vec3& acStart, const glm::vec3& acEnd, Vector<glm::vec3>& aPath) noexcept;
+
+private:
+    struct Tile
+    {
+        Vector<uint32_t> NavMeshIds;
+        uint64_t Ref{0};
+        uint64_t LastQuery{0};
+        // Set once the tile turned out to have no polygons, it is never loaded
+        bool Empty{false};
+        std::list<uint64_t>::iterator LruEntry{};
+    };
+
+    // Everything Detour needs for one world space or interior cell
+    struct Space
+    {
+        ~Space() noexcept;
+
+        bool Exterior{false};
+        dtNavMesh* pNavMesh{nullptr};
+        dtNavMeshQuery* pQuery{nullptr};
+        glm::vec3 Origin{};
+        float TileSize{0.f};
+        uint32_t MaxTilePolys{0};
+        // Tile coordinates spanned by the nav meshes, queries never look outside of them
+        int32_t MinTileX{0};
+        int32_t MinTileY{0};
+        int32_t MaxTileX{0};
+        int32_t MaxTileY{0};
+        Map<uint64_t, Tile> Tiles;
+        // Resident tiles, most recently used first
+        std::list<uint64_t> Lru;
+    };
+
+    Space* GetSpace(const CellIdComponent& acLocation) noexcept;
+    UniquePtr<Space> BuildSpace(uint32_t aParentId, bool aExterior) noexcept;
+    void IndexNavMeshes() noexcept;
+    // Loads the existing tiles overlapping the box, returns false if they don't fit in the tile budget or one fails to load
+    bool LoadTiles(Space& aSpace, const glm::vec3& acMin, const glm::vec3& acMax) noexcept;
+    bool LoadTile(Space& aSpace, uint64_t aKey, Tile& aTile) noexcept;
+
+    World& m_world;
+    bool m_indexed{false};
+    uint64_t m_queryCount{0};
+    struct IndexedNavMesh
+    {
+        uint32_t FormId;
+        uint64_t TileKey;
+    };
+
+    // Nav meshes by world space or interior cell form id
+    Map<uint32_t, Vector<IndexedNavMesh>> m_navMeshesByParent;
+    // Null entries mark locations without nav meshes
+    Map<uint32_t, UniquePtr<Space>> m_spaces;
+};
@@ -64,24 +64,20 @@ void ObjectService::OnAssignObjectsRequest(const PacketEvent<AssignObjectsReques
 
     for (const ObjectData& object : acMessage.Packet.Objects)
     {
-        const auto iter = std::find_if(std::begin(view), std::end(view), [view, id = object.Id](auto entity)
-        {
-            const auto& formIdComponent = view.get<FormIdComponent>(entity);
-            return formIdComponent.Id == id;
-        });
+        const auto cExistingEntity = m_world.GetByFormId(object.Id);
 
-        if (iter != std::end(view))
+        if (cExistingEntity != entt::null && view.contains(cExistingEntity))
         {
             ObjectData objectData;
-            objectData.ServerId = World::ToInteger(*iter);
+            objectData.ServerId = World::ToInteger(cExistingEntity);
 
-            auto& formIdComponent = view.get<FormIdComponent>(*iter);
+            auto& formIdComponent = view.get<FormIdComponent>(cExistingEntity);
             objectData.Id = formIdComponent.Id;
 
-            auto& objectComponent = view.get<ObjectComponent>(*iter);
+            auto& objectComponent = view.get<ObjectComponent>(cExistingEntity);
             objectData.CurrentLockData = objectComponent.CurrentLockData;
 
-            auto& inventoryComponent = view.get<InventoryComponent>(*iter);
+            auto& inventoryComponent = view.get<InventoryComponent>(cExistingEntity);
             objectData.CurrentInventory = inventoryComponent.Content;
 
             objectData.IsSenderFirst = false;
@@ -120,13 +116,7 @@ void ObjectService::OnActivate(const PacketEvent<ActivateRequest>& acMessage) co
     notifyActivate.Id = acMessage.Packet.Id;
     notifyActivate.ActivatorId = acMessage.Packet.ActivatorId;
 
-    for (auto pPlayer : m_world.GetPlayerManager())
-    {
-        if (pPlayer != acMessage.pPlayer && pPlayer->GetCellComponent().Cell == acMessage.Packet.CellId)
-        {
-            pPlayer->Send(notifyActivate);
-        }
-    }
+    GameServer::Get()->SendToCell(notifyActivate, acMessage.Packet.CellId, acMessage.pPlayer);
 }
 
 void ObjectService::OnLockChange(const PacketEvent<LockChangeRequest>& acMessage) const noexcept
@@ -138,27 +128,16 @@ void ObjectService::OnLockChange(const PacketEvent<LockChangeRequest>& acMessage
 
     auto objectView = m_world.view<FormIdComponent, ObjectComponent>();
 
-    const auto iter = std::find_if(std::begin(objectView), std::end(objectView), [objectView, id = acMessage.Packet.Id](auto entity)
-    {
-        const auto& formIdComponent = objectView.get<FormIdComponent>(entity);
-        return formIdComponent.Id == id;
-    });
+    const auto cEntity = m_world.GetByFormId(acMessage.Packet.Id);
 
-    if (iter != std::end(objectView))
+    if (cEntity != entt::null && objectView.contains(cEntity))
     {
-        auto& objectComponent = objectView.get<ObjectComponent>(*iter);
+        auto& objectComponent = objectView.get<ObjectComponent>(cEntity);
         objectComponent.CurrentLockData.IsLocked = acMessage.Packet.IsLocked;
         objectComponent.CurrentLockData.LockLevel = acMessage.Packet.LockLevel;
     }
 
-    for (Player* pPlayer : m_world.GetPlayerManager())
-    {
-        if (pPlayer == acMessage.pPlayer)
-            continue;
-
-        if (pPlayer->GetCellComponent().Cell == acMessage.Packet.CellId)
-            pPlayer->Send(notifyLockChange);
-    }
+    GameServer::Get()->SendToCell(notifyLockChange, acMessage.Packet.CellId, acMessage.pPlayer);
 }
 
 void ObjectService::OnScriptAnimationRequest(const PacketEvent<ScriptAnimationRequest>& acMessage) noexcept
@@ -170,8 +149,5 @@ void ObjectService::OnScriptAnimationRequest(const PacketEvent<ScriptAnimationRe
     message.Animation = packet.Animation;
     message.EventName = packet.EventName;
 
-    for(Player* pPlayer : m_world.GetPlayerManager())
-    {
-        pPlayer->Send(message);
-    }
+    GameServer::Get()->SendToPlayers(message);
 }
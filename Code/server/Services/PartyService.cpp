@@ -1,6 +1,7 @@
 #include <Services/PartyService.h>
 #include <Components.h>
 #include <GameServer.h>
+#include <Profiling/TickProfiler.h>
 
 #include <Events/PlayerJoinEvent.h>
 #include <Events/PlayerLeaveEvent.h>
@@ -72,6 +73,8 @@ PartyService::Party* PartyService::GetPlayerParty(Player* const apPlayer) noexce
 
 void PartyService::OnUpdate(const UpdateEvent& acEvent) noexcept
 {
+    TickProfiler::Scope profile(TickProfiler::Get().GetService("PartyService"));
+
     const auto cCurrentTick = GameServer::Get()->GetTick();
     if (m_nextInvitationExpire > cCurrentTick)
         return;
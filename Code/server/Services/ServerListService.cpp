@@ -1,11 +1,13 @@
+#include <Events/AnnouncementResultEvent.h>
 #include <Events/PlayerJoinEvent.h>
 #include <Events/PlayerLeaveEvent.h>
 #include <Events/UpdateEvent.h>
 #include <GameServer.h>
+#include <Profiling/TickProfiler.h>
 #include <Services/ServerListService.h>
 
+#include <base/threading/ThreadUtils.h>
 #include <console/Setting.h>
-#include <future>
 
 #define CPPHTTPLIB_OPENSSL_SUPPORT
 #include <httplib.h>
@@ -21,11 +23,19 @@ static constexpr char kMasterServerEndpoint[] =
     "https://fallout-reborn-list.skyrim-together.com";
 #endif
 
+// Announcements requested within this delay are merged into a single post
+static constexpr auto kCoalescingDelay = 2s;
+
 static Console::Setting bAnnounceServer{"LiveServices:bAnnounceServer",
                                         "Whether to list the server on the public server list", false};
+static Console::Setting uAnnounceTimeout{"LiveServices:uAnnounceTimeout",
+                                         "Seconds to wait for the server list before an announcement is dropped", 10u};
 
 ServerListService::ServerListService(World& aWorld, entt::dispatcher& aDispatcher) noexcept
     : m_world(aWorld), m_updateConnection(aDispatcher.sink<UpdateEvent>().connect<&ServerListService::OnUpdate>(this)),
+      m_playerJoinConnection(aDispatcher.sink<PlayerJoinEvent>().connect<&ServerListService::OnPlayerJoin>(this)),
+      m_playerLeaveConnection(aDispatcher.sink<PlayerLeaveEvent>().connect<&ServerListService::OnPlayerLeave>(this)),
+      m_announcementResultConnection(aDispatcher.sink<AnnouncementResultEvent>().connect<&ServerListService::OnAnnouncementResult>(this)),
       m_nextAnnounce(std::chrono::seconds(0))
 {
     if (!bAnnounceServer)
@@ -38,74 +48,158 @@ ServerListService::ServerListService(World& aWorld, entt::dispatcher& aDispatche
         spdlog::warn("Your server will not show up on the server list because this server has a password.");
         bAnnounceServer = false;
     }
+
+    m_worker = std::thread(&ServerListService::RunWorker, this);
+}
+
+ServerListService::~ServerListService() noexcept
+{
+    {
+        std::scoped_lock _{m_workerLock};
+        m_stopWorker = true;
+    }
+
+    m_workerCondition.notify_one();
+
+    // Waits for at most one announcement, bounded by uAnnounceTimeout
+    if (m_worker.joinable())
+        m_worker.join();
 }
 
 void ServerListService::OnUpdate(const UpdateEvent& acEvent) noexcept
 {
+    TickProfiler::Scope profile(TickProfiler::Get().GetService("ServerListService"));
+
     if (m_nextAnnounce < std::chrono::steady_clock::now())
     {
         Announce();
 
         m_nextAnnounce = (std::chrono::steady_clock::now() + std::chrono::minutes(1));
     }
+
+    Vector<AnnouncementResultEvent> results;
+    {
+        std::scoped_lock _{m_workerLock};
+        std::swap(results, m_results);
+    }
+
+    for (const auto& result : results)
+        m_world.GetDispatcher().trigger(result);
 }
 
 void ServerListService::OnPlayerJoin(const PlayerJoinEvent& acEvent) noexcept
 {
-    Announce();
-
-    m_nextAnnounce = (std::chrono::steady_clock::now() + std::chrono::minutes(1));
+    // Announce on the next tick, once the player list is up to date
+    m_nextAnnounce = std::chrono::steady_clock::time_point{};
 }
 
 void ServerListService::OnPlayerLeave(const PlayerLeaveEvent& acEvent) noexcept
 {
-    Announce();
+    // Announce on the next tick, once the player list is up to date
+    m_nextAnnounce = std::chrono::steady_clock::time_point{};
+}
 
-    m_nextAnnounce = (std::chrono::steady_clock::now() + std::chrono::minutes(1));
+void ServerListService::OnAnnouncementResult(const AnnouncementResultEvent& acEvent) const noexcept
+{
+    // If we send a 403 it means we banned this server
+    if (acEvent.Status == 403)
+        GameServer::Get()->Kill();
+    else if (acEvent.Status == 0)
+        spdlog::error("Server could not reach the server list! {}", acEvent.Error);
+    else if (acEvent.Status != 200)
+        spdlog::error("Server list error! {}", acEvent.Error);
 }
 
-void ServerListService::Announce() const noexcept
+void ServerListService::Announce() noexcept
 {
     auto* pServer = GameServer::Get();
     const auto& cInfo = pServer->GetInfo();
-    auto pc = static_cast<uint16_t>(m_world.GetPlayerManager().Count());
 
-    auto f = std::async(std::launch::async, PostAnnouncement, cInfo.name, cInfo.desc, cInfo.icon_url, pServer->GetPort(),
-                   cInfo.tick_rate, pc, uMaxPlayerCount.value_as<uint16_t>(), cInfo.tagList, bAnnounceServer);
+    Announcement announcement{};
+    announcement.Name = cInfo.name;
+    announcement.Desc = cInfo.desc;
+    announcement.IconUrl = cInfo.icon_url;
+    announcement.Port = pServer->GetPort();
+    announcement.Tick = cInfo.tick_rate;
+    announcement.PlayerCount = static_cast<uint16_t>(m_world.GetPlayerManager().Count());
+    announcement.PlayerMaxCount = uMaxPlayerCount.value_as<uint16_t>();
+    announcement.TagList = cInfo.tagList;
+    announcement.Public = bAnnounceServer;
+
+    {
+        std::scoped_lock _{m_workerLock};
+        // Only the latest state matters, replace whatever wasn't posted yet
+        m_pendingAnnouncement = std::move(announcement);
+    }
+
+    m_workerCondition.notify_one();
+}
+
+void ServerListService::RunWorker() noexcept
+{
+    Base::SetCurrentThreadName("ServerListWorker");
+
+    std::unique_lock lock(m_workerLock);
+
+    while (true)
+    {
+        m_workerCondition.wait(lock, [this] { return m_stopWorker || m_pendingAnnouncement.has_value(); });
+
+        if (m_stopWorker)
+            return;
+
+        // Give the joins and leaves of a burst a chance to land in the same announcement
+        if (m_workerCondition.wait_for(lock, kCoalescingDelay, [this] { return m_stopWorker; }))
+            return;
+
+        const Announcement cAnnouncement = std::move(*m_pendingAnnouncement);
+        m_pendingAnnouncement.reset();
+
+        lock.unlock();
+        auto result = PostAnnouncement(cAnnouncement);
+        lock.lock();
+
+        m_results.push_back(std::move(result));
+    }
 }
 
-void ServerListService::PostAnnouncement(String acName, String acDesc, String acIconUrl, uint16_t aPort, uint16_t aTick,
-                                         uint16_t aPlayerCount, uint16_t aPlayerMaxCount, String acTagList, bool aPublic) noexcept
+AnnouncementResultEvent ServerListService::PostAnnouncement(const Announcement& acAnnouncement) noexcept
 {
     const std::string kVersion{BUILD_COMMIT};
     const httplib::Params params{
-        {"name", std::string(acName.c_str(), acName.size())},
-        {"desc", std::string(acDesc.c_str(), acDesc.size())},
-        {"icon_url", std::string(acIconUrl.c_str(), acIconUrl.size())},
+        {"name", std::string(acAnnouncement.Name.c_str(), acAnnouncement.Name.size())},
+        {"desc", std::string(acAnnouncement.Desc.c_str(), acAnnouncement.Desc.size())},
+        {"icon_url", std::string(acAnnouncement.IconUrl.c_str(), acAnnouncement.IconUrl.size())},
         {"version", std::string(kVersion.c_str(), kVersion.size())},
-        {"port", std::to_string(aPort)},
-        {"tick", std::to_string(aTick)},
-        {"player_count", std::to_string(aPlayerCount)},
-        {"max_player_count", std::to_string(aPlayerMaxCount)},
-        {"tags", std::string(acTagList.c_str(), acTagList.size())},
-        {"public", aPublic ? "true" : "false" },
+        {"port", std::to_string(acAnnouncement.Port)},
+        {"tick", std::to_string(acAnnouncement.Tick)},
+        {"player_count", std::to_string(acAnnouncement.PlayerCount)},
+        {"max_player_count", std::to_string(acAnnouncement.PlayerMaxCount)},
+        {"tags", std::string(acAnnouncement.TagList.c_str(), acAnnouncement.TagList.size())},
+        {"public", acAnnouncement.Public ? "true" : "false" },
     };
 
+    const auto cTimeout = static_cast<time_t>(uAnnounceTimeout.value_as<uint32_t>());
+
     httplib::Client client(kMasterServerEndpoint);
     client.enable_server_certificate_verification(false);
+    client.set_connection_timeout(cTimeout, 0);
+    client.set_read_timeout(cTimeout, 0);
+    client.set_write_timeout(cTimeout, 0);
+
     const auto response = client.Post("/announce", params);
 
-    // If we send a 203 it means we banned this server
+    AnnouncementResultEvent result{};
     if (response)
     {
-        if (response->status == 403)
-            GameServer::Get()->Kill();
-        else if (response->status != 200)
-            spdlog::error("Server list error! {}", response->body);
-
+        result.Status = response->status;
+        if (response->status != 200)
+            result.Error = response->body.c_str();
     }
     else
     {
-        spdlog::error("Server could not reach the server list! {}", to_string(response.error()));
+        result.Error = to_string(response.error()).c_str();
     }
+
+    return result;
 }
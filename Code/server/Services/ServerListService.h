@@ -1,17 +1,23 @@
 #pragma once
 
+#include <condition_variable>
+#include <thread>
+
 struct World;
 struct UpdateEvent;
 struct PlayerJoinEvent;
 struct PlayerLeaveEvent;
+struct AnnouncementResultEvent;
 
 /**
 * @brief Dispatches the current player list to the clients.
+*
+* Announcements are posted by a background worker, requests made while one is pending are merged into it.
 */
 struct ServerListService
 {
     ServerListService(World& aWorld, entt::dispatcher& aDispatcher) noexcept;
-    ~ServerListService() noexcept = default;
+    ~ServerListService() noexcept;
 
     TP_NOCOPYMOVE(ServerListService);
 
@@ -20,26 +26,40 @@ protected:
     void OnUpdate(const UpdateEvent& acEvent) noexcept;
     void OnPlayerJoin(const PlayerJoinEvent& acEvent) noexcept;
     void OnPlayerLeave(const PlayerLeaveEvent& acEvent) noexcept;
+    void OnAnnouncementResult(const AnnouncementResultEvent& acEvent) const noexcept;
 
 private:
 
-    void Announce() const noexcept;
+    struct Announcement
+    {
+        String Name;
+        String Desc;
+        String IconUrl;
+        uint16_t Port;
+        uint16_t Tick;
+        uint16_t PlayerCount;
+        uint16_t PlayerMaxCount;
+        String TagList;
+        bool Public;
+    };
+
+    void Announce() noexcept;
+    void RunWorker() noexcept;
 
-    static void PostAnnouncement(
-        String acName, 
-        String acDesc, 
-        String acIconUrl, 
-        uint16_t aPort, 
-        uint16_t aTick, 
-        uint16_t aPlayerCount, 
-        uint16_t aPlayerMaxCount, 
-        String acTagList,
-        bool aPublic) noexcept;
+    static AnnouncementResultEvent PostAnnouncement(const Announcement& acAnnouncement) noexcept;
 
     World& m_world;
 
     entt::scoped_connection m_updateConnection;
     entt::scoped_connection m_playerJoinConnection;
     entt::scoped_connection m_playerLeaveConnection;
-    mutable std::chrono::steady_clock::time_point m_nextAnnounce;
+    entt::scoped_connection m_announcementResultConnection;
+    std::chrono::steady_clock::time_point m_nextAnnounce;
+
+    std::mutex m_workerLock;
+    std::condition_variable m_workerCondition;
+    std::optional<Announcement> m_pendingAnnouncement;
+    Vector<AnnouncementResultEvent> m_results;
+    bool m_stopWorker{false};
+    std::thread m_worker;
 };
@@ -1,6 +1,7 @@
 #include "StringCache.h"
 
 #include <GameServer.h>
+#include <Profiling/TickProfiler.h>
 #include <Services/StringCacheService.h>
 #include <Events/UpdateEvent.h>
 #include <Game/Player.h>
@@ -13,6 +14,8 @@ StringCacheService::StringCacheService(World& aWorld, entt::dispatcher& aDispatc
 
 void StringCacheService::HandleUpdate(const UpdateEvent&) const noexcept
 {
+    TickProfiler::Scope profile(TickProfiler::Get().GetService("StringCacheService"));
+
     static std::chrono::steady_clock::time_point lastSendTimePoint;
     constexpr auto cDelayBetweenSnapshots = 2000ms;
 
@@ -14,11 +14,15 @@
 #include <Services/StringCacheService.h>
 #include <Services/CombatService.h>
 #include <Services/WeatherService.h>
+#include <Services/NavMeshService.h>
 
 #include <es_loader/ESLoader.h>
 
 World::World()
 {
+    on_construct<FormIdComponent>().connect<&World::OnFormIdConstruct>(this);
+    on_destroy<FormIdComponent>().connect<&World::OnFormIdDestroy>(this);
+
     m_spAdminService = std::make_shared<AdminService>(*this, m_dispatcher);
     spdlog::default_logger()->sinks().push_back(std::static_pointer_cast<spdlog::sinks::sink>(m_spAdminService));
 
@@ -38,14 +42,89 @@ World::World()
     ctx().emplace<StringCacheService>(*this, m_dispatcher);
     ctx().emplace<CombatService>(*this, m_dispatcher);
     ctx().emplace<WeatherService>(*this, m_dispatcher);
+    ctx().emplace<NavMeshService>(*this, m_dispatcher);
 
     ESLoader::ESLoader loader;
+    // The record index is cached with the plugins it describes
+    loader.SetCachePath(loader.GetDirectory() / "RecordCache.bin");
     // emplace loaded mods into modscomponent.
     m_recordCollection = loader.BuildRecordCollection();
     for (const auto& it : loader.GetLoadOrder())
     {
         ctx().emplace<ModsComponent>().AddServerMod(it);
     }
+
+    BuildWorldSpaceBounds();
+}
+
+World::~World() noexcept
+{
+    on_construct<FormIdComponent>().disconnect(this);
+    on_destroy<FormIdComponent>().disconnect(this);
 }
 
-World::~World() noexcept = default;
+void World::BuildWorldSpaceBounds() noexcept
+{
+    if (!m_recordCollection)
+        return;
+
+    // Exterior cells are 4096 units wide
+    constexpr float kCellSize = 4096.f;
+
+    Map<uint32_t, GridBounds> bounds;
+    for (uint32_t formId : m_recordCollection->GetFormIdsOfType(FormEnum::WRLD))
+    {
+        const WRLD& world = m_recordCollection->GetWorldWithoutReferencesById(formId);
+        if (!world.m_boundsMin || !world.m_boundsMax)
+            continue;
+
+        const glm::vec2 cMin = glm::floor(*world.m_boundsMin / kCellSize);
+        const glm::vec2 cMax = glm::floor(*world.m_boundsMax / kCellSize);
+
+        // Some plugins leave the defaults (+-FLT_MAX) in there, those worlds stay on the sparse path
+        if (!glm::all(glm::lessThanEqual(cMin, cMax)) || glm::any(glm::lessThan(cMin, glm::vec2(-1e6f))) ||
+            glm::any(glm::greaterThan(cMax, glm::vec2(1e6f))))
+            continue;
+
+        GridBounds grid{static_cast<int32_t>(cMin.x), static_cast<int32_t>(cMin.y), static_cast<int32_t>(cMax.x), static_cast<int32_t>(cMax.y)};
+        if (grid.GetWidth() * grid.GetHeight() > Region::kMaxBoundedCells)
+            continue;
+
+        bounds.emplace(formId, grid);
+    }
+
+    spdlog::info("Loaded the grid bounds of {} worldspaces", bounds.size());
+
+    // Worldspace ids carry the mod ids handed out to clients, they can only be resolved when a region is built
+    m_playerManager.GetWorldMap().SetWorldSpaceBounds(std::move(bounds),
+                                                      [this](const GameId& acId) { return ctx().at<ModsComponent>().GetServerFormId(acId); });
+}
+
+entt::entity World::GetByFormId(const GameId& acId) const noexcept
+{
+    const auto itor = m_formIdIndex.find(acId);
+    if (itor == std::end(m_formIdIndex))
+        return entt::null;
+
+    return itor->second;
+}
+
+void World::OnFormIdConstruct(entt::registry& aRegistry, entt::entity aEntity) noexcept
+{
+    const auto& formIdComponent = aRegistry.get<FormIdComponent>(aEntity);
+
+    // Keep the first entity registered for an id, like the view scans this replaces did
+    const auto [itor, inserted] = m_formIdIndex.emplace(formIdComponent.Id, aEntity);
+    if (!inserted)
+        spdlog::warn("FormId {:X}:{:X} is already used by entity {:X}", formIdComponent.Id.ModId,
+                     formIdComponent.Id.BaseId, ToInteger(itor->second));
+}
+
+void World::OnFormIdDestroy(entt::registry& aRegistry, entt::entity aEntity) noexcept
+{
+    const auto& formIdComponent = aRegistry.get<FormIdComponent>(aEntity);
+
+    const auto itor = m_formIdIndex.find(formIdComponent.Id);
+    if (itor != std::end(m_formIdIndex) && itor->second == aEntity)
+        m_formIdIndex.erase(itor);
+}
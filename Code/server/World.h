@@ -7,6 +7,7 @@
 #include <Services/CharacterService.h>
 #include <Services/CalendarService.h>
 #include <Services/QuestService.h>
+#include <Services/NavMeshService.h>
 
 #include "Game/PlayerManager.h"
 
@@ -34,6 +35,7 @@ struct World : entt::registry
     const CalendarService& GetCalendarService() const noexcept { return ctx().at<const CalendarService>(); }
     QuestService& GetQuestService() noexcept { return ctx().at<QuestService>(); }
     const QuestService& GetQuestService() const noexcept { return ctx().at<const QuestService>(); }
+    NavMeshService& GetNavMeshService() noexcept { return ctx().at<NavMeshService>(); }
     PlayerManager& GetPlayerManager() noexcept { return m_playerManager; }
     const PlayerManager& GetPlayerManager() const noexcept { return m_playerManager; }
 
@@ -50,8 +52,17 @@ struct World : entt::registry
 
     [[nodiscard]] static uint32_t ToInteger(entt::entity aEntity) { return to_integral(aEntity); }
 
+    // Entity owning the FormIdComponent with this id, entt::null if there is none
+    [[nodiscard]] entt::entity GetByFormId(const GameId& acId) const noexcept;
+
 private:
+    // Exterior grid extent of each worldspace, lets the world map index players in flat arrays
+    void BuildWorldSpaceBounds() noexcept;
+    void OnFormIdConstruct(entt::registry& aRegistry, entt::entity aEntity) noexcept;
+    void OnFormIdDestroy(entt::registry& aRegistry, entt::entity aEntity) noexcept;
+
     entt::dispatcher m_dispatcher;
+    Map<GameId, entt::entity> m_formIdIndex;
 
     TiltedPhoques::SharedPtr<AdminService> m_spAdminService;
     PlayerManager m_playerManager;
@@ -28,6 +28,7 @@ struct GameServerInstance final : IGameServerInstance
     void Shutdown() override;
     bool IsListening() override;
     bool IsRunning() override;
+    uint32_t GetTickRate() override;
     void Update() override;
 
 private:
@@ -55,9 +56,14 @@ bool GameServerInstance::IsRunning()
     return m_gameServer.IsRunning();
 }
 
+uint32_t GameServerInstance::GetTickRate()
+{
+    return m_gameServer.GetInfo().tick_rate;
+}
+
 void GameServerInstance::Update()
 {
-    m_gameServer.Update();
+    m_gameServer.Tick();
 }
 
 // NOTE(Vince): For now we use this to compare the dll to the server.
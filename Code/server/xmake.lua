@@ -35,7 +35,8 @@ local function build_server()
         "entt",
         "cpp-httplib",
         "tiltedcore",
-        "sentry-native")
+        "sentry-native",
+        "recastnavigation")
 end
 
 target("SkyrimTogetherServer")
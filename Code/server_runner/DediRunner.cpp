@@ -38,18 +38,25 @@ DediRunner::DediRunner(int argc, char** argv)
     s_pRunner = this;
 
     uv_loop_init(&m_loop);
+    uv_timer_init(&m_loop, &m_tickTimer);
 
     m_pServerInstance = std::move(CreateGameServer(m_console, [this, argc, argv]() { LoadSettings(argc, argv); }));
 
     // it is here for now..
     m_pServerInstance->Initialize();
     SaveSettingsToIni(m_console, m_SettingsPath);
+
+    m_console.RegisterCommand<>("ShowTickStats", "Shows tick jitter and duration statistics since the last call",
+                                [this](Console::ArgStack&) { PrintTickStats(); });
 }
 
 DediRunner::~DediRunner()
 {
     if (m_useIni)
         SaveSettingsToIni(m_console, m_SettingsPath);
+
+    uv_close(reinterpret_cast<uv_handle_t*>(&m_tickTimer), nullptr);
+    uv_run(&m_loop, UV_RUN_NOWAIT);
     uv_loop_close(&m_loop);
 }
 
@@ -128,6 +135,9 @@ void DediRunner::RunGSThread()
 {
     while (m_pServerInstance->IsListening())
     {
+        m_scheduler.SetTickRate(m_pServerInstance->GetTickRate());
+
+        m_scheduler.BeginTick();
         m_pServerInstance->Update();
         if (bConsole)
         {
@@ -135,9 +145,54 @@ void DediRunner::RunGSThread()
             if (m_console.Update())
                 PrintExecutorArrowHack();
         }
+        m_scheduler.EndTick();
+
+        WaitForNextTick();
     }
 }
 
+void DediRunner::WaitForNextTick()
+{
+    using namespace std::chrono;
+
+    // Block in the event loop while there is time left so console input is handled as soon as it arrives, the
+    // scheduler then takes care of the last sub millisecond part.
+    while (bConsole)
+    {
+        const auto cWaitTime = duration_cast<milliseconds>(m_scheduler.GetCoarseWaitTime());
+        if (cWaitTime <= 0ms)
+            break;
+
+        uv_update_time(&m_loop);
+        uv_timer_start(&m_tickTimer, [](uv_timer_t*) {}, static_cast<uint64_t>(cWaitTime.count()), 0);
+        uv_run(&m_loop, UV_RUN_ONCE);
+        uv_timer_stop(&m_tickTimer);
+
+        if (m_console.Update())
+            PrintExecutorArrowHack();
+    }
+
+    m_scheduler.WaitForNextTick();
+}
+
+void DediRunner::PrintTickStats()
+{
+    using namespace std::chrono;
+
+    const auto cStats = m_scheduler.GetStats();
+    const auto cToMicroseconds = [](Base::TickScheduler::Clock::duration aDuration) {
+        return duration_cast<microseconds>(aDuration).count();
+    };
+
+    spdlog::get("ConOut")->info(
+        "Ticks: {} ({} overruns)\nJitter: mean {}us, stddev {}us, max {}us\nDuration: mean {}us, max {}us",
+        cStats.TickCount, cStats.OverrunCount, cToMicroseconds(cStats.MeanJitter),
+        cToMicroseconds(cStats.JitterStdDev), cToMicroseconds(cStats.MaxJitter), cToMicroseconds(cStats.MeanDuration),
+        cToMicroseconds(cStats.MaxDuration));
+
+    m_scheduler.ResetStats();
+}
+
 
 void DediRunner::StartTerminalIO()
 {
@@ -10,6 +10,7 @@
 #include <console/ConsoleRegistry.h>
 #include <console/IniSettingsProvider.h>
 #include <common/GameServerInstance.h>
+#include <base/threading/TickScheduler.h>
 
 #ifdef _WIN32
 #define GS_IMPORT extern __declspec(dllimport)
@@ -38,6 +39,8 @@ private:
     static void PrintExecutorArrowHack();
 
     void LoadSettings(int argc, char** argv);
+    void WaitForNextTick();
+    void PrintTickStats();
 
     static void ReadStdin(uv_stream_t* apStream, ssize_t aRead, const uv_buf_t* acpBuffer);
     static void AllocateBuffer(uv_handle_t* apHandle, size_t aSuggestedSize, uv_buf_t* apBuffer);
@@ -47,10 +50,12 @@ private:
     // Order here matters for constructor calling order.
     uv_loop_t m_loop;
     uv_tty_t m_tty;
+    uv_timer_t m_tickTimer;
     fs::path m_SettingsPath;
     bool m_useIni{ false };
     Console::ConsoleRegistry m_console;
     TiltedPhoques::UniquePtr<IGameServerInstance> m_pServerInstance;
+    Base::TickScheduler m_scheduler{60};
 };
 
 DediRunner* GetDediRunner() noexcept;
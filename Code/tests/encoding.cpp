@@ -4,6 +4,7 @@
 #include <TiltedCore/Serialization.hpp>
 
 #include <optional>
+#include <tuple>
 
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
@@ -15,6 +16,7 @@
 
 #include <Messages/ClientMessageFactory.h>
 #include <Messages/ServerMessageFactory.h>
+#include <MessageBundle.h>
 #include <Structs/Vector2_NetQuantize.h>
  
 #include <TiltedCore/Math.hpp>
@@ -65,6 +67,103 @@ TEST_CASE("Encoding factory", "[encoding.factory]")
     }
 }
 
+namespace
+{
+// Encodes the two messages made by acMake in turn and checks that both the thread local instance of Decode and the
+// slot of DecodeInto, which are reused from one message to the next, hold exactly the last message
+template <class TMake> void CheckDecodeReuse(const TMake& acMake)
+{
+    using TMessage = decltype(acMake(0));
+    static_assert(ReusableClientMessage<TMessage>);
+
+    Buffer buff(1000);
+    UniquePtr<ClientMessage> pSlot;
+
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        const TMessage request = acMake(i);
+
+        Buffer::Writer writer(&buff);
+        request.Serialize(writer);
+
+        {
+            Buffer::Reader reader(&buff);
+
+            uint32_t calls = 0;
+            const bool decoded = ClientMessageFactory::Decode(reader, [&](auto& aMessage) {
+                using T = std::remove_reference_t<decltype(aMessage)>;
+                ++calls;
+
+                if constexpr (std::is_same_v<T, TMessage>)
+                    REQUIRE(aMessage == request);
+                else
+                    FAIL("Decoded the wrong message type");
+            });
+
+            REQUIRE(decoded);
+            REQUIRE(calls == 1);
+        }
+
+        {
+            Buffer::Reader reader(&buff);
+
+            const ClientMessage* pPrevious = pSlot.get();
+            REQUIRE(ClientMessageFactory::DecodeInto(reader, pSlot));
+            REQUIRE(pSlot->GetOpcode() == TMessage::Opcode);
+            REQUIRE(static_cast<const TMessage&>(*pSlot) == request);
+
+            if (pPrevious)
+                REQUIRE(pSlot.get() == pPrevious);
+        }
+    }
+}
+}
+
+TEST_CASE("Encoding factory decode reuses messages", "[encoding.factory]")
+{
+    // One entry per reusable message, the second message must not keep anything of the first one
+    const auto cMakers = std::make_tuple(
+        [](uint32_t aIndex) {
+            ClientReferencesMoveRequest request;
+            request.Tick = 42 + aIndex;
+            request.Updates[aIndex + 1].UpdatedMovement.Position = glm::vec3(1.f, 2.f, 3.f);
+            return request;
+        },
+        [](uint32_t aIndex) {
+            RequestActorValueChanges request;
+            request.Id = 7 + aIndex;
+            request.Values[aIndex + 1] = 100.f;
+            return request;
+        },
+        [](uint32_t aIndex) {
+            RequestActorMaxValueChanges request;
+            request.Id = 9 + aIndex;
+            request.Values[aIndex + 1] = 250.f;
+            return request;
+        },
+        [](uint32_t aIndex) {
+            RequestFactionsChanges request;
+            Faction faction;
+            faction.Id = GameId(aIndex, 0x1234);
+            faction.Rank = static_cast<int8_t>(aIndex);
+            request.Changes[aIndex + 1].NpcFactions.push_back(faction);
+            return request;
+        },
+        [](uint32_t aIndex) {
+            RequestHealthChangeBroadcast request;
+            request.Id = 11 + aIndex;
+            request.DeltaHealth = -5.f * (aIndex + 1);
+            return request;
+        },
+        [](uint32_t aIndex) {
+            RequestPlayerHealthUpdate request;
+            request.Percentage = 0.25f * (aIndex + 1);
+            return request;
+        });
+
+    std::apply([](const auto&... acMake) { (CheckDecodeReuse(acMake), ...); }, cMakers);
+}
+
 TEST_CASE("Static structures", "[encoding.static]")
 {
     GIVEN("GameId")
@@ -475,6 +574,48 @@ TEST_CASE("Packets", "[encoding.packets]")
         REQUIRE(recvMessage.Updates[1].UpdatedMovement == sendMessage.Updates[1].UpdatedMovement);
         
     }
+
+    GIVEN("ServerReferencesMoveRequest delta")
+    {
+        Movement baseline;
+        baseline.Position.x = 100.f;
+        baseline.Position.y = 200.f;
+        baseline.Direction = 0.5f;
+        baseline.Variables.Booleans = 0x12345678ull;
+        baseline.Variables.Integers = {1, 2, 3};
+        baseline.Variables.Floats = {1.f, 7.f};
+
+        Movement current = baseline;
+        current.Position.x = 150.f;
+        current.Variables.Integers[1] = 42;
+
+        ServerReferencesMoveRequest sendMessage, recvMessage;
+        auto& update = sendMessage.Updates[1];
+        update.UpdatedMovement = current;
+        update.MakeDelta(baseline);
+
+        REQUIRE(update.MovementChanges == (Movement::kPositionChanged | Movement::kVariablesChanged));
+        REQUIRE(update.VariableChanges == (1ull << 2));
+
+        Buffer buff(1000);
+        Buffer::Writer writer(&buff);
+        sendMessage.Serialize(writer);
+
+        Buffer::Reader reader(&buff);
+
+        uint64_t trash;
+        reader.ReadBits(trash, 8); // pop opcode
+
+        recvMessage.DeserializeRaw(reader);
+
+        const auto& recvUpdate = recvMessage.Updates[1];
+        REQUIRE(recvUpdate.IsDelta);
+
+        Movement resolved = baseline;
+        recvUpdate.ApplyTo(resolved);
+
+        REQUIRE(resolved == current);
+    }
 }
 
 TEST_CASE("StringCache", "[encoding.string_cache]")
@@ -500,3 +641,55 @@ TEST_CASE("StringCache", "[encoding.string_cache]")
         REQUIRE(update == recvUpdate);
     }
 }
+
+TEST_CASE("Message bundles", "[encoding.bundle]")
+{
+    StringCacheUpdate first;
+    first.Values[0] = "Hello";
+
+    // Long enough for a two byte size prefix
+    StringCacheUpdate second;
+    second.Values[1] = String(200, 'a');
+
+    Vector<uint8_t> bundle{kServerMessageBundle};
+    auto append = [&bundle](const ServerMessage& acMessage) {
+        Buffer buff(1000);
+        Buffer::Writer writer(&buff);
+        acMessage.Serialize(writer);
+
+        uint8_t prefix[MessageBundle::kMaxSizePrefix];
+        const size_t cPrefixSize = MessageBundle::WriteSize(prefix, static_cast<uint32_t>(writer.Size()));
+        bundle.insert(bundle.end(), prefix, prefix + cPrefixSize);
+        bundle.insert(bundle.end(), buff.GetData(), buff.GetData() + writer.Size());
+    };
+
+    append(first);
+    append(second);
+
+    REQUIRE(MessageBundle::IsBundle(bundle.data(), bundle.size()));
+
+    Vector<StringCacheUpdate> received;
+    const bool cValid = MessageBundle::ForEach(bundle.data(), bundle.size(), [&received](const uint8_t* apData, size_t aSize) {
+        ViewBuffer view(const_cast<uint8_t*>(apData), aSize);
+        Buffer::Reader reader(&view);
+
+        auto pMessage = ServerMessageFactory{}.Extract(reader);
+        REQUIRE(pMessage);
+        REQUIRE(pMessage->GetOpcode() == kStringCacheUpdate);
+
+        received.push_back(static_cast<const StringCacheUpdate&>(*pMessage));
+    });
+
+    REQUIRE(cValid);
+    REQUIRE(received.size() == 2);
+    REQUIRE(received[0] == first);
+    REQUIRE(received[1] == second);
+
+    // Cut in the middle of the last message
+    REQUIRE_FALSE(MessageBundle::ForEach(bundle.data(), bundle.size() - 1, [](const uint8_t*, size_t) {}));
+
+    // Bundles are split before decoding, the factory doesn't take them
+    ViewBuffer view(bundle.data(), bundle.size());
+    Buffer::Reader reader(&view);
+    REQUIRE_FALSE(ServerMessageFactory{}.Extract(reader));
+}
@@ -13,3 +13,5 @@ includes("server_runner")
 includes("server")
 includes("encoding")
 includes("tests")
+includes("load_generator")
+includes("es_loader_bench")